@@ -71,8 +71,10 @@ void app_main(void)
     ESP_LOGI(TAG, "2. Run: idf.py add-dependency \"espressif/esp_lvgl_port>=2.0\"");
     ESP_LOGI(TAG, "3. Design UI in EEZ Studio (800x480, RGB565)");
     ESP_LOGI(TAG, "4. Export C code to main/ui/");
-    ESP_LOGI(TAG, "5. Build: idf.py build");
-    ESP_LOGI(TAG, "6. Flash: idf.py flash monitor");
+    ESP_LOGI(TAG, "5. Add UI_SRCS and UI_GLUE_SRCS to main/CMakeLists.txt and call");
+    ESP_LOGI(TAG, "   ui_screens_init()/ui_screens_tick() from the LVGL task");
+    ESP_LOGI(TAG, "6. Build: idf.py build");
+    ESP_LOGI(TAG, "7. Flash: idf.py flash monitor");
     ESP_LOGI(TAG, "");
 
     // Idle loop
@@ -0,0 +1,59 @@
+/**
+ * @file ui_screens.c
+ * @brief Screen cache wiring for the EEZ Studio export
+ *
+ * Kept outside the export so a re-export does not overwrite it. Screens
+ * are deleted by the flow runtime through the objects table, so only the
+ * create functions have to be listed here, one per ScreensEnum entry.
+ * Screens with "Create at start" unticked in EEZ Studio are left out of
+ * the exported create_screens() and built here on first navigation.
+ */
+
+#include "ui_screens.h"
+#include "ui.h"
+#include "screens.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+static const char *TAG = "ui_screens";
+
+typedef void (*create_screen_func_t)(void);
+
+static const create_screen_func_t create_screen_funcs[] = {
+    create_screen_main,
+};
+
+static void create_screen(int screen_index)
+{
+    if (screen_index >= 0 && screen_index < (int)(sizeof(create_screen_funcs) / sizeof(create_screen_funcs[0]))) {
+        create_screen_funcs[screen_index]();
+    }
+}
+
+void ui_screens_init(size_t cache_budget)
+{
+    // registered before ui_init(), which loads the first screen and must be
+    // able to create it when it is not created at start
+    eez_flow_set_create_screen_func(create_screen);
+    eez_flow_set_screen_cache_budget(cache_budget);
+
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    int64_t start = esp_timer_get_time();
+
+    ui_init();
+
+    int64_t elapsed = esp_timer_get_time() - start;
+    size_t free_after = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    ESP_LOGI(TAG, "ui_init: %lld us, %u bytes of heap",
+             (long long)elapsed, (unsigned)(free_before > free_after ? free_before - free_after : 0));
+}
+
+void ui_screens_tick(void)
+{
+    eez_flow_tick();
+    int16_t screen_id = eez_flow_get_current_screen();
+    if (eez_flow_is_screen_created(screen_id)) {
+        tick_screen(screen_id - 1);
+    }
+}
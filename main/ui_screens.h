@@ -0,0 +1,37 @@
+/**
+ * @file ui_screens.h
+ * @brief Screen cache wiring for the EEZ Studio export
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initialize the EEZ UI and enable the screen cache
+ *
+ * Registers the per-screen create functions, then calls ui_init(). Screens
+ * that are not created at start are built when they are first shown, and
+ * any screen can be rebuilt after the cache has evicted it. Logs the time
+ * and heap that ui_init() took.
+ *
+ * @param cache_budget Bytes of LVGL objects the cache may keep for
+ *                     screens that are not shown; 0 disables eviction
+ */
+void ui_screens_init(size_t cache_budget);
+
+/**
+ * @brief Run the flow and tick the current screen
+ *
+ * Use instead of ui_tick(). The exported ui_tick() ticks the current screen
+ * even when it has not been created.
+ */
+void ui_screens_tick(void);
+
+#ifdef __cplusplus
+}
+#endif
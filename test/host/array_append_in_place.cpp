@@ -0,0 +1,126 @@
+// Test of SetVariable `v = Array.append(v, i)` growing the array in place.
+// The flow is built in memory:
+//   Start -> v = Array.allocate(0) -> Loop(i from 0 to NUM_ELEMENTS - 1)
+//         -> v = Array.append(v, i) -> Loop.next
+//   Loop.done -> w = v -> v = Array.append(v, 0)
+// The loop must leave v as [0 .. NUM_ELEMENTS - 1] held only by v, with
+// spare capacity (the copying path allocates exact sizes). The last two
+// steps check that an append to a shared array still copies, so w keeps
+// its NUM_ELEMENTS elements.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "flow_builder.h"
+#include <stdio.h>
+
+using namespace eez;
+using namespace eez::flow;
+using namespace flow_builder;
+
+static const int NUM_ELEMENTS = 20000;
+
+// flow values: 0..5 sequence inputs, 6 v, 7 w, 8 i
+static const uint16_t V = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 0;
+static const uint16_t W = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 1;
+static const uint16_t I = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 2;
+static const uint16_t ZERO = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 0;
+static const uint16_t APPEND = EXPR_EVAL_INSTRUCTION_TYPE_OPERATION | defs_v3::OPERATION_TYPE_ARRAY_APPEND;
+static const uint16_t ALLOCATE = EXPR_EVAL_INSTRUCTION_TYPE_OPERATION | defs_v3::OPERATION_TYPE_ARRAY_ALLOCATE;
+
+static Component *setVariable(uint16_t inputIndex, uint16_t variable, std::initializer_list<uint16_t> value, Connection *next) {
+    auto c = component<SetVariableActionComponent>(defs_v3::COMPONENT_TYPE_SET_VARIABLE_ACTION);
+    setList(c->inputs, { inputIndex });
+    auto entry = arenaAlloc<SetVariableEntry>();
+    entry->variable = instructions({ variable });
+    entry->value = instructions(value);
+    setList(c->entries, { entry });
+    if (next) {
+        setList(c->outputs, { output({ next }, true) });
+    } else {
+        setList(c->outputs, { output({}, true) });
+    }
+    return c;
+}
+
+static Assets *buildAssets() {
+    auto start = component(defs_v3::COMPONENT_TYPE_START_ACTION);
+    setList(start->outputs, { output({ connection(1, 0) }, true) });
+
+    auto init = setVariable(0, V, { ZERO, ALLOCATE }, connection(2, 1));
+
+    auto loop = component(defs_v3::COMPONENT_TYPE_LOOP_ACTION);
+    setList(loop->inputs, { (uint16_t)1, (uint16_t)2 });
+    setList(loop->properties, {
+        expr({ I }),
+        expr({ ZERO }),
+        expr({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 1 }),
+        expr({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 2 })
+    });
+    setList(loop->outputs, { output({ connection(3, 3) }, true), output({ connection(4, 4) }, false) });
+
+    auto append = setVariable(3, V, { I, V, APPEND }, connection(2, 2));
+    auto share = setVariable(4, W, { V }, connection(5, 5));
+    auto appendShared = setVariable(5, V, { ZERO, V, APPEND }, nullptr);
+
+    auto flow = arenaAlloc<Flow>();
+    setList(flow->components, { start, init, loop, append, share, appendShared });
+    setList(flow->localVariables, { arenaAlloc<Value>(), arenaAlloc<Value>(), constant(0) });
+    setList(flow->componentInputs, {
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT
+    });
+
+    return flowAssets(flow, { constant(0), constant(NUM_ELEMENTS - 1), constant(1) });
+}
+
+static int check(const Value &value, int expectedSize, const char *name) {
+    if (value.type != VALUE_TYPE_ARRAY_REF) {
+        fprintf(stderr, "%s: not an array ref\n", name);
+        return 1;
+    }
+    auto array = value.getArray();
+    if ((int)array->arraySize != expectedSize) {
+        fprintf(stderr, "%s: %u elements, expected %d\n", name, (unsigned)array->arraySize, expectedSize);
+        return 1;
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (array->values[i].getInt() != i) {
+            fprintf(stderr, "%s[%d] = %d\n", name, i, array->values[i].getInt());
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    g_mainAssets = buildAssets();
+    start(g_mainAssets);
+    auto flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+    while (getQueueSize() > 0) {
+        tick();
+    }
+    if (flowState->error) {
+        fprintf(stderr, "flow error\n");
+        return 1;
+    }
+    auto &v = flowState->values[6];
+    auto &w = flowState->values[7];
+    if (check(w, NUM_ELEMENTS, "w") || check(v, NUM_ELEMENTS + 1, "v")) {
+        return 1;
+    }
+    auto wRef = (ArrayValueRef *)w.refValue;
+    if (wRef->capacity <= wRef->arrayValue.arraySize || wRef->refCounter != 1) {
+        fprintf(stderr, "w: capacity %u, refCounter %u, the loop did not append in place\n", (unsigned)wRef->capacity, (unsigned)wRef->refCounter);
+        return 1;
+    }
+    freeFlowState(flowState);
+    printf("ok\n");
+    return 0;
+}
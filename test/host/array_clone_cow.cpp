@@ -0,0 +1,160 @@
+// Test of Array.clone() on a table of structs. The clone copies only the
+// top-level array and shares the rows copy-on-write, so a write through
+// either table must not show up in the other one, while a row alias taken
+// with `r = t[i]` must keep seeing writes to t[i]. ArrayOf<T>::at() must
+// detach the row it returns, or return an error value when it cannot
+// allocate the copy. At the end the clone is timed and its heap use is
+// printed; build the previous revision of eez-flow.cpp with the same file
+// to compare against the deep copy.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "flow_builder.h"
+#include <stdio.h>
+#include <chrono>
+
+using namespace eez;
+using namespace eez::flow;
+using namespace flow_builder;
+
+static const int NUM_ROWS = 1000;
+static const int NUM_FIELDS = 4;
+static const int NUM_RUNS = 1000;
+
+// flow values: 0 t, 1 c, 2 r, 3 d
+static const uint16_t T = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 0;
+static const uint16_t C = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 1;
+static const uint16_t R = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 2;
+static const uint16_t ROW_0 = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 0;
+static const uint16_t ROW_1 = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 1;
+static const uint16_t ROW_500 = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 2;
+static const uint16_t FIELD_1 = EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 1;
+static const uint16_t ELEMENT = EXPR_EVAL_INSTRUCTION_ARRAY_ELEMENT;
+static const uint16_t CLONE = EXPR_EVAL_INSTRUCTION_TYPE_OPERATION | defs_v3::OPERATION_TYPE_ARRAY_CLONE;
+
+static FlowState *g_flowState;
+
+static Assets *buildAssets() {
+    auto noop = component(defs_v3::COMPONENT_TYPE_NOOP_ACTION);
+    auto flow = arenaAlloc<Flow>();
+    setList(flow->components, { noop });
+    setList(flow->localVariables, { arenaAlloc<Value>(), arenaAlloc<Value>(), arenaAlloc<Value>(), arenaAlloc<Value>() });
+    return flowAssets(flow, { constant(0), constant(1), constant(500) });
+}
+
+static Value eval(const uint8_t *expression) {
+    Value result;
+    evalExpression(g_flowState, 0, expression, result, FlowError::Plain("eval"));
+    return result;
+}
+
+static void assign(std::initializer_list<uint16_t> target, int value) {
+    Value dstValue;
+    evalAssignableExpression(g_flowState, 0, instructions(target), dstValue, FlowError::Plain("assign"));
+    assignValue(g_flowState, 0, dstValue, Value(value, VALUE_TYPE_INT32));
+}
+
+static int field(const Value &table, int row) {
+    return table.getArray()->values[row].getArray()->values[1].getInt();
+}
+
+static bool sameRow(const Value &a, const Value &b, int row) {
+    return a.getArray()->values[row].refValue == b.getArray()->values[row].refValue;
+}
+
+struct RowValue {
+    Value value;
+    RowValue(Value value_) : value(value_) {}
+};
+typedef ArrayOf<RowValue, defs_v3::ARRAY_TYPE_ANY> Table;
+
+static int fail(const char *message) {
+    fprintf(stderr, "%s\n", message);
+    return 1;
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    g_mainAssets = buildAssets();
+    start(g_mainAssets);
+    g_flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+    auto &t = g_flowState->values[0];
+    auto &c = g_flowState->values[1];
+    auto &r = g_flowState->values[2];
+    auto &d = g_flowState->values[3];
+
+    t = Value::makeArrayRef(NUM_ROWS, defs_v3::ARRAY_TYPE_ANY, 0);
+    for (int i = 0; i < NUM_ROWS; i++) {
+        auto row = Value::makeArrayRef(NUM_FIELDS, defs_v3::ARRAY_TYPE_ANY, 0);
+        for (int j = 0; j < NUM_FIELDS; j++) {
+            row.getArray()->values[j] = Value(i, VALUE_TYPE_INT32);
+        }
+        t.getArray()->values[i] = row;
+    }
+
+    auto cloneT = instructions({ T, CLONE });
+    c = eval(cloneT);
+    if (!c.isArray() || c.refValue == t.refValue || !sameRow(c, t, 0) || !sameRow(c, t, NUM_ROWS - 1)) {
+        return fail("clone does not share the rows");
+    }
+
+    assign({ C, ROW_0, ELEMENT, FIELD_1, ELEMENT }, 99);
+    if (field(c, 0) != 99 || field(t, 0) != 0 || sameRow(c, t, 0) || !sameRow(c, t, 1)) {
+        return fail("write through the clone is not isolated");
+    }
+
+    assign({ T, ROW_500, ELEMENT, FIELD_1, ELEMENT }, 77);
+    if (field(t, 500) != 77 || field(c, 500) != 500) {
+        return fail("write through the original is not isolated");
+    }
+
+    r = eval(instructions({ T, ROW_1, ELEMENT }));
+    assign({ R, FIELD_1, ELEMENT }, 55);
+    if (field(t, 1) != 55 || field(c, 1) != 1) {
+        return fail("row alias does not see the original row");
+    }
+
+    d = eval(cloneT);
+    if (sameRow(d, t, 1) || !sameRow(d, t, 2)) {
+        return fail("aliased row is shared by the clone");
+    }
+    assign({ R, FIELD_1, ELEMENT }, 56);
+    if (field(t, 1) != 56 || field(d, 1) != 55) {
+        return fail("write through the row alias reached the clone");
+    }
+
+    Value e = eval(cloneT);
+    lv_stub_malloc_fails = true;
+    auto failedRow = Table(e).at(2);
+    lv_stub_malloc_fails = false;
+    if (!failedRow.value.isError() || !sameRow(e, t, 2)) {
+        return fail("ArrayOf::at() did not report the failed detach");
+    }
+    auto row = Table(e).at(2);
+    if (!row.value.isArray() || sameRow(e, t, 2)) {
+        return fail("ArrayOf::at() did not detach the row");
+    }
+    e = Value();
+
+    uint32_t freeBefore, allocBefore, freeAfter, allocAfter;
+    getAllocInfo(freeBefore, allocBefore);
+    Value probe = eval(cloneT);
+    getAllocInfo(freeAfter, allocAfter);
+    probe = Value();
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int run = 0; run < NUM_RUNS; run++) {
+        Value value = eval(cloneT);
+        if (!value.isArray()) {
+            return fail("clone failed");
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    printf("clone of %d rows: %.1f us, %u bytes\n", NUM_ROWS, elapsed * 1e6 / NUM_RUNS, (unsigned)(allocAfter - allocBefore));
+    freeFlowState(g_flowState);
+    printf("ok\n");
+    return 0;
+}
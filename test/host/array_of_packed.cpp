@@ -0,0 +1,96 @@
+// Test of the ArrayOfInteger/ArrayOfFloat/ArrayOfDouble helpers. Arrays are
+// boxed by default, so every isArray() consumer accepts them. Packed storage
+// is used only when asked for, and it round-trips element values. Both
+// storages carry the element array type, and a packed array converts to
+// boolean and text and sorts like a boxed one.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "ui.h"
+#include <stdio.h>
+#include <string.h>
+#include <initializer_list>
+
+using namespace eez;
+
+static const int NUM_ELEMENTS = 1000;
+
+template<typename A, typename T>
+static int check(const char *name, bool packed, uint32_t arrayType) {
+    A array(NUM_ELEMENTS, packed);
+    Value value = array;
+    if (value.isArray() == packed || value.isPackedArray() != packed) {
+        fprintf(stderr, "%s(packed=%d): value type %d\n", name, packed, value.type);
+        return 1;
+    }
+    if ((packed ? value.getPackedArray()->arrayType : value.getArray()->arrayType) != arrayType) {
+        fprintf(stderr, "%s(packed=%d): wrong array type\n", name, packed);
+        return 1;
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        array.at(i, (T)i / 2);
+    }
+    if (array.size() != NUM_ELEMENTS) {
+        fprintf(stderr, "%s(packed=%d): size %u\n", name, packed, (unsigned)array.size());
+        return 1;
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (array.at(i) != (T)i / 2) {
+            fprintf(stderr, "%s(packed=%d)[%d] wrong\n", name, packed, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int checkPackedConsumers() {
+    ArrayOfInteger array(4, true);
+    Value value = array;
+    if (ArrayOfInteger(0, true).value.toBool() || !value.toBool()) {
+        fprintf(stderr, "packed toBool wrong\n");
+        return 1;
+    }
+    for (int i = 0; i < 4; i++) {
+        array.at(i, (i * 3) % 4);
+    }
+    char text[32];
+    value.toText(text, sizeof(text));
+    if (strcmp(text, "0, 3, 2, 1") != 0) {
+        fprintf(stderr, "packed toText: \"%s\"\n", text);
+        return 1;
+    }
+    static flow::SortArrayActionComponent component;
+    component.arrayType = -1;
+    component.flags = SORT_ARRAY_FLAG_ASCENDING;
+    if (!flow::sortArray(&component, value.getPackedArray())) {
+        fprintf(stderr, "packed sort failed\n");
+        return 1;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (array.at(i) != i) {
+            fprintf(stderr, "packed sort [%d] = %d\n", i, array.at(i));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    for (bool packed : { false, true }) {
+        if (
+            check<ArrayOfInteger, int>("ArrayOfInteger", packed, flow::defs_v3::ARRAY_TYPE_INTEGER) ||
+            check<ArrayOfFloat, float>("ArrayOfFloat", packed, flow::defs_v3::ARRAY_TYPE_FLOAT) ||
+            check<ArrayOfDouble, double>("ArrayOfDouble", packed, flow::defs_v3::ARRAY_TYPE_DOUBLE)
+        ) {
+            return 1;
+        }
+    }
+    if (checkPackedConsumers()) {
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,180 @@
+// Test of the EEZ_FLOW_DUAL_CORE hand-off between the flow task and the LVGL
+// task. The flow is built in memory:
+//   Noop.out -> Record -> out[n % 3] -> CallAction(native action n % 3)
+// Record is a stub executor registered for the Log component type, so it
+// runs on the flow task, while native CallAction components must run on the
+// LVGL task. Two threads drive the runtime through its real entry points:
+//  - the flow thread runs the loop of flowTask(): executePostedEvents() and
+//    tick() under the flow lock, and tick() hands the CallAction components
+//    over with postToLvglCore(),
+//  - the LVGL thread runs eez_flow_tick(), which executes them with
+//    executePostedOnLvglCore(), and raises events on the Noop output with
+//    flowPropagateValueInt32(), some of them from inside a native action,
+//    that is while it holds the flow lock.
+// Record must see the events in the order they were raised, and the native
+// actions must run on the LVGL thread in the order Record posted them.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "flow_builder.h"
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+
+using namespace eez;
+using namespace eez::flow;
+using namespace flow_builder;
+
+static const int32_t NUM_EVENTS = 20000;
+static const uint32_t NUM_ACTIONS = 3;
+// Events raised but not yet through their native action, kept below the
+// size of the LVGL core queue so the flow queue never fills up.
+static const int32_t MAX_EVENTS_IN_FLIGHT = 32;
+
+static FlowState *g_flowState;
+static std::thread::id g_flowThreadId;
+static std::thread::id g_lvglThreadId;
+static std::atomic<bool> g_stopFlowThread;
+static std::atomic<bool> g_failed;
+
+// written under the flow lock
+static int32_t g_numRecorded;
+static int32_t g_lastRecordedEvent = -1;
+static int32_t g_numActions;
+
+// written by the LVGL thread only
+static int32_t g_nextEvent;
+
+static void fail(const char *message) {
+    if (!g_failed.exchange(true)) {
+        fprintf(stderr, "%s\n", message);
+    }
+}
+
+// flow inputs: 0 Record input, 1 Noop seq input, 2..4 CallAction seq inputs
+static Assets *buildAssets() {
+    // the Noop seq input is never connected, so Noop does not run at start
+    // and its output only carries the events raised by the LVGL thread
+    auto noop = component(defs_v3::COMPONENT_TYPE_NOOP_ACTION);
+    setList(noop->inputs, { (uint16_t)1 });
+    setList(noop->outputs, { output({ connection(1, 0) }, false) });
+
+    auto record = component(defs_v3::COMPONENT_TYPE_LOG_ACTION);
+    setList(record->inputs, { (uint16_t)0 });
+    setList(record->outputs, {
+        output({ connection(2, 2) }, false),
+        output({ connection(3, 3) }, false),
+        output({ connection(4, 4) }, false)
+    });
+
+    // action flow indexes past the last flow are native actions, and
+    // executeActionFunction() passes index - 1 to executeLvglActionHook
+    auto callAction = [](uint16_t inputIndex, int16_t actionFlowIndex) -> Component * {
+        auto callAction = component<CallActionActionComponent>(defs_v3::COMPONENT_TYPE_CALL_ACTION_ACTION);
+        setList(callAction->inputs, { inputIndex });
+        callAction->flowIndex = actionFlowIndex;
+        return callAction;
+    };
+
+    auto flow = arenaAlloc<Flow>();
+    setList(flow->components, { noop, record, callAction(2, 2), callAction(3, 3), callAction(4, 4) });
+    setList(flow->componentInputs, {
+        (ComponentInput)0,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT
+    });
+
+    // constant 1 is the null value propagated through seq outputs
+    return flowAssets(flow, { constant(0), arenaAlloc<Value>() });
+}
+
+static void executeRecord(FlowState *flowState, unsigned componentIndex) {
+    if (std::this_thread::get_id() != g_flowThreadId) {
+        fail("Record did not run on the flow thread");
+    }
+    // a burst of events collapses into the last value of the input before
+    // Record runs, so the values it sees only have to keep increasing
+    int32_t event = flowState->values[0].getInt();
+    if (event < g_lastRecordedEvent) {
+        fail("events reached Record out of order");
+    }
+    g_lastRecordedEvent = event;
+    propagateValue(flowState, componentIndex, g_numRecorded++ % NUM_ACTIONS);
+}
+
+static void raiseEvent() {
+    flowPropagateValueInt32(g_flowState, 0, 0, g_nextEvent++);
+}
+
+static void executeAction(int actionIndex) {
+    if (std::this_thread::get_id() != g_lvglThreadId || !g_isExecutingOnLvglCore) {
+        fail("native action did not run on the LVGL thread");
+    }
+    if (actionIndex != (int)(g_numActions % NUM_ACTIONS)) {
+        fail("native actions ran out of order");
+    }
+    g_numActions++;
+    // an event raised synchronously by the action, under the flow lock
+    if (g_numActions % 4 == 0 && g_nextEvent < NUM_EVENTS) {
+        raiseEvent();
+    }
+}
+
+static void flowThread() {
+    g_flowThreadId = std::this_thread::get_id();
+    while (!g_stopFlowThread) {
+        lockFlow();
+        executePostedEvents();
+        tick();
+        unlockFlow();
+        std::this_thread::yield();
+    }
+}
+
+static void lvglThread() {
+    g_lvglThreadId = std::this_thread::get_id();
+    while (!g_failed && g_numActions < NUM_EVENTS) {
+        eez_flow_tick();
+        for (int i = 0; i < 8 && g_nextEvent < NUM_EVENTS && g_nextEvent - g_numActions < MAX_EVENTS_IN_FLIGHT; i++) {
+            raiseEvent();
+        }
+        std::this_thread::yield();
+    }
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    initFlowLock();
+    g_mainAssets = buildAssets();
+    registerComponent(defs_v3::COMPONENT_TYPE_LOG_ACTION, executeRecord);
+    executeLvglActionHook = executeAction;
+    start(g_mainAssets);
+    g_flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+
+    std::thread flow(flowThread);
+    std::thread lvgl(lvglThread);
+    lvgl.join();
+    g_stopFlowThread = true;
+    flow.join();
+
+    if (g_failed) {
+        return 1;
+    }
+    if (g_numRecorded != NUM_EVENTS || g_lastRecordedEvent != NUM_EVENTS - 1) {
+        fprintf(stderr, "Record ran %d times, last event %d\n", (int)g_numRecorded, (int)g_lastRecordedEvent);
+        return 1;
+    }
+    if (g_numActions != NUM_EVENTS) {
+        fprintf(stderr, "native actions ran %d times\n", (int)g_numActions);
+        return 1;
+    }
+
+    freeFlowState(g_flowState);
+    printf("%d events in order\n", (int)NUM_EVENTS);
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Helpers for host tests that build a flow definition in memory instead of
+// loading the project's assets. Everything is laid out in one static arena
+// so the AssetsPtr offsets stay valid for the whole run.
+#pragma once
+#include "ui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <initializer_list>
+#include <new>
+
+namespace flow_builder {
+
+using namespace eez;
+using namespace eez::flow;
+
+alignas(8) static uint8_t g_arena[65536];
+static size_t g_arenaUsed;
+
+template<typename T>
+static T *arenaAlloc(size_t n = 1) {
+    auto p = g_arena + g_arenaUsed;
+    g_arenaUsed += (sizeof(T) * n + 7) & ~7;
+    if (g_arenaUsed > sizeof(g_arena)) {
+        fprintf(stderr, "arena overflow\n");
+        exit(1);
+    }
+    memset(p, 0, sizeof(T) * n);
+    return (T *)p;
+}
+
+template<typename T>
+static void setList(ListOfAssetsPtr<T> &list, T *const *items, size_t count) {
+    // ListOfAssetsPtr has the same layout as a list of AssetsPtr<T>
+    auto &raw = reinterpret_cast<ListOfFundamentalType<AssetsPtr<T>> &>(list);
+    auto ptrs = arenaAlloc<AssetsPtr<T>>(count);
+    for (size_t i = 0; i < count; i++) {
+        ptrs[i] = items[i];
+    }
+    raw.count = count;
+    raw.items = ptrs;
+}
+
+template<typename T>
+static void setList(ListOfAssetsPtr<T> &list, std::initializer_list<T *> items) {
+    setList(list, items.begin(), items.size());
+}
+
+template<typename T>
+static void setList(ListOfFundamentalType<T> &list, std::initializer_list<T> items) {
+    auto values = arenaAlloc<T>(items.size());
+    size_t i = 0;
+    for (auto item : items) {
+        values[i++] = item;
+    }
+    list.count = items.size();
+    list.items = values;
+}
+
+static uint8_t *instructions(std::initializer_list<uint16_t> items) {
+    auto p = arenaAlloc<uint16_t>(items.size() + 1);
+    size_t i = 0;
+    for (auto item : items) {
+        p[i++] = item;
+    }
+    p[i] = EXPR_EVAL_INSTRUCTION_TYPE_END;
+    return (uint8_t *)p;
+}
+
+static Property *expr(std::initializer_list<uint16_t> items) {
+    return (Property *)instructions(items);
+}
+
+static Connection *connection(uint16_t targetComponentIndex, uint16_t targetInputIndex) {
+    auto c = arenaAlloc<Connection>();
+    c->targetComponentIndex = targetComponentIndex;
+    c->targetInputIndex = targetInputIndex;
+    return c;
+}
+
+static ComponentOutput *output(std::initializer_list<Connection *> connections, bool isSeqOut) {
+    auto o = arenaAlloc<ComponentOutput>();
+    setList(o->connections, connections);
+    o->isSeqOut = isSeqOut;
+    return o;
+}
+
+template<typename T = Component>
+static T *component(uint16_t type) {
+    auto c = arenaAlloc<T>();
+    c->type = type;
+    c->errorCatchOutput = -1;
+    return c;
+}
+
+static Value *constant(int value) {
+    return new (arenaAlloc<Value>()) Value(value, VALUE_TYPE_INT32);
+}
+
+static Assets *flowAssets(Flow *flow, std::initializer_list<Value *> constants) {
+    auto flowDefinition = arenaAlloc<FlowDefinition>();
+    setList(flowDefinition->flows, { flow });
+    setList(flowDefinition->constants, constants);
+    auto assets = arenaAlloc<Assets>();
+    assets->flowDefinition = flowDefinition;
+    return assets;
+}
+
+} // namespace flow_builder
@@ -0,0 +1,37 @@
+// Benchmark of action flow state creation/destruction, the part of
+// executeCallAction() that the flow state pool (EEZ_FLOW_STATE_POOL_SIZE)
+// affects. Each iteration creates an action flow state of the project's
+// page flow under a page flow state and frees it again; tick() runs every
+// 64 iterations to drain the queue entries left by freed flow states.
+//
+// The `check` target of test/host/CMakeLists.txt builds and runs it once
+// with the default pool and once with EEZ_FLOW_STATE_POOL_SIZE=0 to compare.
+#include "ui.h"
+#include <stdio.h>
+#include <chrono>
+
+using namespace eez;
+using namespace eez::flow;
+
+static const int NUM_ITERATIONS = 1000000;
+
+int main() {
+    initAssetsMemory();
+    loadMainAssets(assets, sizeof(assets));
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    start(g_mainAssets);
+    auto pageFlowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        auto flowState = initActionFlowState(0, pageFlowState, -1, Value(i, VALUE_TYPE_INT32));
+        freeFlowState(flowState);
+        if (i % 64 == 63) {
+            tick();
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    printf("EEZ_FLOW_STATE_POOL_SIZE=%d: %.0f action flow states/s\n", EEZ_FLOW_STATE_POOL_SIZE, NUM_ITERATIONS / elapsed);
+    freeFlowState(pageFlowState);
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Stress test for flow state reference tracking (incRefCounterForFlowState,
+// decRefCounterForFlowState, canFreeFlowState) with 8-deep action nesting.
+//
+// Builds a tree of action flow states, 8 levels deep with two children per
+// state on the first levels, applies random reference inc/dec operations
+// and checks after every step that canFreeFlowState() matches the original
+// definition: an action state can be freed when neither it nor any of its
+// descendants holds a reference.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "eez-flow.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace eez::flow;
+
+static const int MAX_DEPTH = 8;
+static const int BRANCHING_DEPTH = 4;
+static const int NUM_STEPS = 200000;
+
+struct Node {
+    FlowState flowState;
+    uint32_t ownRefs;
+    std::vector<Node *> children;
+};
+
+static std::vector<Node *> g_nodes;
+
+static Node *createNode(Node *parent, int depth) {
+    auto node = new Node();
+    node->flowState.isAction = depth > 0;
+    node->flowState.parentFlowState = parent ? &parent->flowState : nullptr;
+    g_nodes.push_back(node);
+    if (parent) {
+        parent->children.push_back(node);
+    }
+    if (depth < MAX_DEPTH) {
+        createNode(node, depth + 1);
+        if (depth < BRANCHING_DEPTH) {
+            createNode(node, depth + 1);
+        }
+    }
+    return node;
+}
+
+static uint32_t subtreeRefs(Node *node) {
+    uint32_t refs = node->ownRefs;
+    for (auto child : node->children) {
+        refs += subtreeRefs(child);
+    }
+    return refs;
+}
+
+static bool check(int step) {
+    for (size_t i = 0; i < g_nodes.size(); i++) {
+        auto node = g_nodes[i];
+        bool expected = node->flowState.isAction && subtreeRefs(node) == 0;
+        if (canFreeFlowState(&node->flowState) != expected) {
+            printf("FAIL: step %d, node %u: canFreeFlowState() = %d, expected %d\n", step, (unsigned)i, !expected, expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    createNode(nullptr, 0);
+    srand(1);
+    for (int step = 0; step < NUM_STEPS; step++) {
+        auto node = g_nodes[rand() % g_nodes.size()];
+        if (node->ownRefs > 0 && rand() % 2) {
+            node->ownRefs--;
+            decRefCounterForFlowState(&node->flowState);
+        } else {
+            node->ownRefs++;
+            incRefCounterForFlowState(&node->flowState);
+        }
+        if (!check(step)) {
+            return 1;
+        }
+    }
+    for (auto node : g_nodes) {
+        while (node->ownRefs > 0) {
+            node->ownRefs--;
+            decRefCounterForFlowState(&node->flowState);
+        }
+    }
+    if (!check(NUM_STEPS)) {
+        return 1;
+    }
+    for (auto node : g_nodes) {
+        if (node->flowState.refCounter != 0 || node->flowState.numActiveChildren != 0) {
+            printf("FAIL: counters not back to zero\n");
+            return 1;
+        }
+    }
+    printf("OK: %u flow states, %d steps\n", (unsigned)g_nodes.size(), NUM_STEPS);
+    for (auto node : g_nodes) {
+        delete node;
+    }
+    return 0;
+}
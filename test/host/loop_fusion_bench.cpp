@@ -0,0 +1,77 @@
+// Benchmark of Loop iterations per millisecond. The flow is built in memory:
+// Start -> Loop(i from 0 to NUM_LOOP_ITERATIONS - 1) -> Noop -> Loop.next,
+// so the loop body is made only of synchronous components. Each run creates
+// the flow state and ticks until the queue is empty, then checks that the
+// loop ran every iteration and left the loop variable one step past To.
+//
+// The `check` target of test/host/CMakeLists.txt builds and runs it once
+// with the default (loop fusion on) and once with EEZ_FLOW_LOOP_FUSION=0 to
+// compare.
+#include "flow_builder.h"
+#include <stdio.h>
+#include <chrono>
+
+using namespace eez;
+using namespace eez::flow;
+using namespace flow_builder;
+
+static const int NUM_LOOP_ITERATIONS = 10000;
+static const int NUM_RUNS = 200;
+
+// flow values: 0 Loop.start, 1 Loop.next, 2 Noop.seq, 3 local variable i
+static Assets *buildAssets() {
+    auto start = component(defs_v3::COMPONENT_TYPE_START_ACTION);
+    setList(start->outputs, { output({ connection(1, 0) }, true) });
+
+    auto loop = component(defs_v3::COMPONENT_TYPE_LOOP_ACTION);
+    setList(loop->inputs, { (uint16_t)0, (uint16_t)1 });
+    setList(loop->properties, {
+        expr({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 0 }),
+        expr({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 0 }),
+        expr({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 1 }),
+        expr({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | 2 })
+    });
+    setList(loop->outputs, { output({ connection(2, 2) }, true), output({}, false) });
+
+    auto noop = component(defs_v3::COMPONENT_TYPE_NOOP_ACTION);
+    setList(noop->inputs, { (uint16_t)2 });
+    setList(noop->outputs, { output({ connection(1, 1) }, true) });
+
+    auto flow = arenaAlloc<Flow>();
+    setList(flow->components, { start, loop, noop });
+    setList(flow->localVariables, { constant(0) });
+    setList(flow->componentInputs, {
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT
+    });
+
+    return flowAssets(flow, { constant(0), constant(NUM_LOOP_ITERATIONS - 1), constant(1) });
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    g_mainAssets = buildAssets();
+    start(g_mainAssets);
+    unsigned numTicks = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int run = 0; run < NUM_RUNS; run++) {
+        auto iterationsBefore = getLoopIterationCounter();
+        auto flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+        while (getQueueSize() > 0) {
+            tick();
+            numTicks++;
+        }
+        if (getLoopIterationCounter() - iterationsBefore != NUM_LOOP_ITERATIONS || flowState->values[3].getInt() != NUM_LOOP_ITERATIONS) {
+            fprintf(stderr, "run %d: %u iterations, i = %d\n", run, getLoopIterationCounter() - iterationsBefore, flowState->values[3].getInt());
+            return 1;
+        }
+        freeFlowState(flowState);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    printf("fusion %d: %.0f iterations/ms, %.1f ticks per run\n", EEZ_FLOW_LOOP_FUSION,
+        (double)NUM_RUNS * NUM_LOOP_ITERATIONS / (elapsed * 1e3), (double)numTicks / NUM_RUNS);
+    return 0;
+}
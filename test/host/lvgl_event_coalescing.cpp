@@ -0,0 +1,89 @@
+// Test of replaceQueuedValue(), which LVGL event coalescing uses to fold a
+// new event into one that is still waiting in the queue. The flow is built
+// in memory:
+//   Noop.out -> v = input
+// The queued event is replaced by the newer one, and the older event value
+// itself is never modified. Once the component has run and v holds the
+// event, a newer event must not be folded in, so v keeps what it received.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "flow_builder.h"
+#include <stdio.h>
+
+using namespace eez;
+using namespace eez::flow;
+using namespace flow_builder;
+
+// flow values: 0 SetVariable input, 1 v
+static Assets *buildAssets() {
+    auto noop = component(defs_v3::COMPONENT_TYPE_NOOP_ACTION);
+    setList(noop->outputs, { output({ connection(1, 0) }, false) });
+
+    auto setVariable = component<SetVariableActionComponent>(defs_v3::COMPONENT_TYPE_SET_VARIABLE_ACTION);
+    setList(setVariable->inputs, { (uint16_t)0 });
+    auto entry = arenaAlloc<SetVariableEntry>();
+    entry->variable = instructions({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 0 });
+    entry->value = instructions({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_INPUT | 0 });
+    setList(setVariable->entries, { entry });
+    setList(setVariable->outputs, { output({}, true) });
+
+    auto flow = arenaAlloc<Flow>();
+    setList(flow->components, { noop, (Component *)setVariable });
+    setList(flow->localVariables, { arenaAlloc<Value>() });
+    setList(flow->componentInputs, { (ComponentInput)0 });
+
+    // constant 1 is the null value propagated through seq outputs
+    return flowAssets(flow, { constant(0), arenaAlloc<Value>() });
+}
+
+static Value event(int32_t userData) {
+    return Value::makeLVGLEventRef(LV_EVENT_VALUE_CHANGED, nullptr, nullptr, userData, 0, 0, 0, 0);
+}
+
+static int fail(const char *message) {
+    fprintf(stderr, "%s\n", message);
+    return 1;
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    g_mainAssets = buildAssets();
+    start(g_mainAssets);
+    auto flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+    auto &v = flowState->values[1];
+    // Noop has no inputs, so it runs once when the flow state starts
+    while (getQueueSize() > 0) {
+        tick();
+    }
+
+    Value first = event(1);
+    Value second = event(2);
+    propagateValue(flowState, 0, 0, first);
+    if (!replaceQueuedValue(flowState, 0, 0, first, second)) {
+        return fail("queued event was not replaced");
+    }
+    if (getQueueSize() != 1 || first.getLVGLEventRef()->userData != 1) {
+        return fail("replacing the queued event changed the queue or the older event");
+    }
+    while (getQueueSize() > 0) {
+        tick();
+    }
+    if (v.type != VALUE_TYPE_EVENT || v.getLVGLEventRef()->userData != 2) {
+        return fail("component did not receive the newer event");
+    }
+
+    Value third = event(3);
+    if (replaceQueuedValue(flowState, 0, 0, second, third)) {
+        return fail("event was replaced after the component consumed it");
+    }
+    if (v.getLVGLEventRef()->userData != 2) {
+        return fail("consumed event was modified");
+    }
+
+    freeFlowState(flowState);
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,151 @@
+// Benchmark of an LVGL component that updates 100 labels on one screen.
+// The flow is built in memory:
+//   Start -> LVGL(for every label: text = "a", add flag hidden,
+//                 text = "b", hidden = false)
+// Every label gets two writes to each of two (object, property) keys, and
+// the hidden flag ends where it started. With the per-tick write batch only
+// the last write of every key is applied, when the tick ends, and unchanged
+// values are skipped, so a run costs one LVGL object write per label.
+// Without it (EEZ_FLOW_LVGL_MAX_PENDING_WRITES=0) every action writes
+// through, four writes per label.
+//
+// The `check` target of test/host/CMakeLists.txt builds and runs it once
+// with the default and once with EEZ_FLOW_LVGL_MAX_PENDING_WRITES=0 to
+// compare.
+#include "flow_builder.h"
+#include <stdio.h>
+#include <chrono>
+
+using namespace eez;
+using namespace eez::flow;
+using namespace flow_builder;
+
+static const int NUM_WIDGETS = 100;
+static const int NUM_ACTIONS_PER_WIDGET = 4;
+static const int NUM_RUNS = 1000;
+
+// the LVGL component type, between OnEvent and OverrideStyle, has no name in
+// defs_v3 (COMPONENT_TYPE_LVGL_ACTION is the LVGL API component)
+static const uint16_t COMPONENT_TYPE_LVGL = 1030;
+
+// the PropertyCode values of eez-flow.cpp
+static const uint32_t BASIC_HIDDEN = 8;
+static const uint32_t LABEL_TEXT = 15;
+
+static lv_obj_t *g_widgets[NUM_WIDGETS];
+
+static lv_obj_t *getWidget(int32_t index) {
+    return index >= 0 && index < NUM_WIDGETS ? g_widgets[index] : nullptr;
+}
+
+static LVGLComponent_ActionType *setProperty(int32_t target, uint32_t property, uint16_t constantIndex) {
+    auto action = arenaAlloc<LVGLComponent_SetProperty_ActionType>();
+    action->action = SET_PROPERTY;
+    action->target = target;
+    action->property = property;
+    action->value = instructions({ (uint16_t)(EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT | constantIndex) });
+    action->textarea = -1;
+    return action;
+}
+
+static LVGLComponent_ActionType *addFlag(int32_t target, uint32_t flag) {
+    auto action = arenaAlloc<LVGLComponent_AddFlag_ActionType>();
+    action->action = ADD_FLAG;
+    action->target = target;
+    action->flag = flag;
+    return action;
+}
+
+static Value *stringConstant(const char *value) {
+    return new (arenaAlloc<Value>()) Value(value, VALUE_TYPE_STRING);
+}
+
+// constants: 0 "a", 1 null, 2 "b", 3 false
+static Assets *buildAssets() {
+    auto start = component(defs_v3::COMPONENT_TYPE_START_ACTION);
+    setList(start->outputs, { output({ connection(1, 0) }, true) });
+
+    static LVGLComponent_ActionType *actions[NUM_WIDGETS * NUM_ACTIONS_PER_WIDGET];
+    auto action = actions;
+    for (int32_t i = 0; i < NUM_WIDGETS; i++) {
+        *action++ = setProperty(i, LABEL_TEXT, 0);
+        *action++ = addFlag(i, LV_OBJ_FLAG_HIDDEN);
+        *action++ = setProperty(i, LABEL_TEXT, 2);
+        *action++ = setProperty(i, BASIC_HIDDEN, 3);
+    }
+    auto lvgl = component<LVGLComponent>(COMPONENT_TYPE_LVGL);
+    setList(lvgl->inputs, { (uint16_t)0 });
+    setList(lvgl->actions, actions, NUM_WIDGETS * NUM_ACTIONS_PER_WIDGET);
+    setList(lvgl->outputs, { output({}, true) });
+
+    auto flow = arenaAlloc<Flow>();
+    setList(flow->components, { start, (Component *)lvgl });
+    setList(flow->componentInputs, { (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT });
+
+    return flowAssets(flow, {
+        stringConstant("a"),
+        arenaAlloc<Value>(),
+        stringConstant("b"),
+        new (arenaAlloc<Value>()) Value(false, VALUE_TYPE_BOOLEAN)
+    });
+}
+
+static void resetWidgets() {
+    for (int i = 0; i < NUM_WIDGETS; i++) {
+        lv_label_set_text(g_widgets[i], "");
+    }
+}
+
+static bool checkWidgets() {
+    for (int i = 0; i < NUM_WIDGETS; i++) {
+        auto widget = g_widgets[i];
+        if (strcmp(lv_label_get_text(widget), "b") != 0 || lv_obj_has_flag(widget, LV_OBJ_FLAG_HIDDEN)) {
+            fprintf(stderr, "label %d has the wrong final state\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    auto screen = lv_obj_create(nullptr);
+    for (int i = 0; i < NUM_WIDGETS; i++) {
+        g_widgets[i] = lv_label_create(screen);
+    }
+    getLvglObjectFromIndexHook = getWidget;
+    g_mainAssets = buildAssets();
+    start(g_mainAssets);
+
+    unsigned numTicks = 0;
+    uint32_t numWrites = 0;
+    double elapsed = 0;
+    for (int run = 0; run < NUM_RUNS; run++) {
+        resetWidgets();
+        auto writesBefore = lv_stub_num_obj_writes;
+        auto startTime = std::chrono::steady_clock::now();
+        auto flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+        while (getQueueSize() > 0) {
+            tick();
+            numTicks++;
+        }
+        elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        numWrites += lv_stub_num_obj_writes - writesBefore;
+        if (!checkWidgets()) {
+            return 1;
+        }
+        freeFlowState(flowState);
+    }
+
+    printf("max pending writes %d: %.1f us, %.1f ticks, %u LVGL object writes per run\n",
+        EEZ_FLOW_LVGL_MAX_PENDING_WRITES, elapsed * 1e6 / NUM_RUNS, (double)numTicks / NUM_RUNS, (unsigned)(numWrites / NUM_RUNS));
+    if (EEZ_FLOW_LVGL_MAX_PENDING_WRITES >= 2 * NUM_WIDGETS && numWrites != (uint32_t)NUM_WIDGETS * NUM_RUNS) {
+        fprintf(stderr, "writes were not coalesced\n");
+        return 1;
+    }
+    lv_obj_delete(screen);
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,33 @@
+// Benchmark of page flow state creation, the flow engine part of a page
+// switch (LVGL screen creation is not included). Each iteration creates
+// the project's page flow state, drains the start components it queued
+// and frees it again.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "ui.h"
+#include <stdio.h>
+#include <chrono>
+
+using namespace eez;
+using namespace eez::flow;
+
+static const int NUM_ITERATIONS = 1000000;
+
+int main() {
+    initAssetsMemory();
+    loadMainAssets(assets, sizeof(assets));
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    start(g_mainAssets);
+    auto flow = static_cast<FlowDefinition *>(g_mainAssets->flowDefinition)->flows[0];
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        auto flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+        tick();
+        freeFlowState(flowState);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    printf("%u components: %.0f ns per page flow state\n", (unsigned)flow->components.count, elapsed * 1e9 / NUM_ITERATIONS);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Test of the roller options cache behind compareRollerOptions(). The cache
+// is keyed by the roller's address, so a roller created where a deleted one
+// was must not hit the deleted roller's entry. The test caches the options
+// of a roller, deletes it and creates another with different options of the
+// same length and option count. malloc usually hands the new roller and its
+// options the addresses of the deleted ones, and a stale entry would then
+// report the options as unchanged.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "ui.h"
+#include <stdio.h>
+
+static const char *OPTIONS = "ab\ncd";
+static const char *OTHER_OPTIONS = "xy\nzw";
+// more than the EEZ_FLOW_ROLLER_OPTIONS_CACHE_SIZE default of 8
+static const int NUM_ROLLERS = 24;
+
+static int compare(lv_obj_t *roller, const char *options) {
+    return compareRollerOptions((lv_roller_t *)roller, options, lv_roller_get_options(roller), 0);
+}
+
+int main() {
+    auto screen = lv_obj_create(nullptr);
+
+    auto roller = lv_roller_create(screen);
+    lv_roller_set_options(roller, OPTIONS, 0);
+    if (compare(roller, OPTIONS) != 0 || compare(roller, OPTIONS) != 0) {
+        fprintf(stderr, "equal options compare as different\n");
+        return 1;
+    }
+    if (compare(roller, OTHER_OPTIONS) == 0) {
+        fprintf(stderr, "different options compare as equal\n");
+        return 1;
+    }
+
+    auto oldRoller = roller;
+    auto oldOptions = lv_roller_get_options(roller);
+    lv_obj_delete(roller);
+    roller = lv_roller_create(screen);
+    lv_roller_set_options(roller, OTHER_OPTIONS, 0);
+    bool reused = roller == oldRoller && lv_roller_get_options(roller) == oldOptions;
+    if (compare(roller, OPTIONS) == 0) {
+        fprintf(stderr, "a new roller hit the entry of a deleted roller\n");
+        return 1;
+    }
+
+    // more rollers than cache entries, so entries of live rollers are replaced
+    lv_obj_t *rollers[NUM_ROLLERS];
+    for (auto &r : rollers) {
+        r = lv_roller_create(screen);
+        lv_roller_set_options(r, OPTIONS, 0);
+        if (compare(r, OPTIONS) != 0) {
+            fprintf(stderr, "equal options compare as different\n");
+            return 1;
+        }
+    }
+    for (auto &r : rollers) {
+        if (compare(r, OPTIONS) != 0 || compare(r, OTHER_OPTIONS) == 0) {
+            fprintf(stderr, "a replaced entry changed the result\n");
+            return 1;
+        }
+    }
+
+    lv_obj_delete(screen);
+    printf("roller address %s\n", reused ? "reused" : "not reused");
+    printf("ok\n");
+    return 0;
+}
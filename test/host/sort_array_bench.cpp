@@ -0,0 +1,120 @@
+// Benchmark of the SortArray component on arrays of structs, sorted by one
+// integer field. The flow is built in memory:
+//   Start -> SortArray(t by field 0, ascending) -> Noop.input
+// Each run creates the flow state, sets t to a table of NUM_ROWS rows with
+// keys from 0 to 999, so there are many equal keys, and ticks until the
+// queue is empty. Arrays of EEZ_FLOW_SORT_ARRAY_INCREMENTAL_MIN_SIZE
+// elements or more go through the incremental sorter, which yields when the
+// tick budget is spent, so the time includes those yields. The result must be ordered by key and keep
+// rows with equal keys in their original order.
+//
+// Built and run with the other host tests by the `check` target of
+// test/host/CMakeLists.txt.
+#include "flow_builder.h"
+#include <stdio.h>
+#include <chrono>
+
+using namespace eez;
+using namespace eez::flow;
+using namespace flow_builder;
+
+static const int32_t ROW_TYPE = 1000;
+static const int32_t ROW_ARRAY_TYPE = 1001;
+static const int NUM_FIELDS = 2;
+static const int KEY_FIELD = 0;
+static const int INDEX_FIELD = 1;
+
+// flow values: 0 SortArray seq input, 1 Noop input, 2 local variable t
+static Assets *buildAssets() {
+    auto start = component(defs_v3::COMPONENT_TYPE_START_ACTION);
+    setList(start->outputs, { output({ connection(1, 0) }, true) });
+
+    auto sortArray = component<SortArrayActionComponent>(defs_v3::COMPONENT_TYPE_SORT_ARRAY_ACTION);
+    setList(sortArray->inputs, { (uint16_t)0 });
+    setList(sortArray->properties, { expr({ EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR | 0 }) });
+    setList(sortArray->outputs, { output({ connection(2, 1) }, false) });
+    sortArray->arrayType = ROW_ARRAY_TYPE;
+    sortArray->structFieldIndex = KEY_FIELD;
+    sortArray->flags = SORT_ARRAY_FLAG_ASCENDING;
+
+    auto noop = component(defs_v3::COMPONENT_TYPE_NOOP_ACTION);
+    setList(noop->inputs, { (uint16_t)1 });
+
+    auto flow = arenaAlloc<Flow>();
+    setList(flow->components, { start, (Component *)sortArray, noop });
+    setList(flow->localVariables, { arenaAlloc<Value>() });
+    setList(flow->componentInputs, {
+        (ComponentInput)COMPONENT_INPUT_FLAG_IS_SEQ_INPUT,
+        (ComponentInput)0
+    });
+
+    // constant 1 is the null value propagated through seq outputs
+    return flowAssets(flow, { constant(0), arenaAlloc<Value>() });
+}
+
+static Value makeTable(int numRows) {
+    auto table = Value::makeArrayRef(numRows, ROW_ARRAY_TYPE, 0);
+    uint32_t seed = 12345;
+    for (int i = 0; i < numRows; i++) {
+        seed = seed * 1103515245 + 12345;
+        auto row = Value::makeArrayRef(NUM_FIELDS, ROW_TYPE, 0);
+        row.getArray()->values[KEY_FIELD] = Value((int)((seed >> 16) % 1000), VALUE_TYPE_INT32);
+        row.getArray()->values[INDEX_FIELD] = Value(i, VALUE_TYPE_INT32);
+        table.getArray()->values[i] = row;
+    }
+    return table;
+}
+
+static bool isSortedAndStable(const Value &value, int numRows) {
+    if (!value.isArray() || (int)value.getArray()->arraySize != numRows) {
+        return false;
+    }
+    auto rows = value.getArray()->values;
+    for (int i = 1; i < numRows; i++) {
+        auto previous = rows[i - 1].getArray()->values;
+        auto row = rows[i].getArray()->values;
+        auto previousKey = previous[KEY_FIELD].getInt();
+        auto key = row[KEY_FIELD].getInt();
+        if (key < previousKey || (key == previousKey && row[INDEX_FIELD].getInt() < previous[INDEX_FIELD].getInt())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bench(int numRows, int numRuns) {
+    Value table = makeTable(numRows);
+    unsigned numTicks = 0;
+    double elapsed = 0;
+    for (int run = 0; run < numRuns; run++) {
+        auto flowState = initPageFlowState(g_mainAssets, 0, nullptr, -1);
+        flowState->values[2] = table;
+        auto startTime = std::chrono::steady_clock::now();
+        while (getQueueSize() > 0) {
+            tick();
+            numTicks++;
+        }
+        elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        if (!isSortedAndStable(flowState->values[1], numRows)) {
+            fprintf(stderr, "%d rows: run %d is not sorted\n", numRows, run);
+            return false;
+        }
+        freeFlowState(flowState);
+    }
+    printf("SortArray of %d structs: %.1f us, %.1f ticks per sort\n", numRows,
+        elapsed * 1e6 / numRuns, (double)numTicks / numRuns);
+    return true;
+}
+
+int main() {
+    initAssetsMemory();
+    initOtherMemory();
+    initAllocHeap(ALLOC_BUFFER, ALLOC_BUFFER_SIZE);
+    g_mainAssets = buildAssets();
+    start(g_mainAssets);
+    if (!bench(1000, 200) || !bench(10000, 20)) {
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,38 @@
+// Minimal stand-in for the FreeRTOS API used by eez-flow.cpp when it is built
+// with EEZ_FLOW_DUAL_CORE. Tasks are std::threads, the recursive mutex is a
+// std::recursive_mutex and a tick is one millisecond. Definitions are in
+// ../freertos_stub.cpp.
+#ifndef HOST_STUB_FREERTOS_H
+#define HOST_STUB_FREERTOS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define portMAX_DELAY 0xffffffffu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+typedef struct {
+    volatile int locked;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+#define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_STUB_FREERTOS_H
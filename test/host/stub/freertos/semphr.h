@@ -0,0 +1,22 @@
+#ifndef HOST_STUB_SEMPHR_H
+#define HOST_STUB_SEMPHR_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct HostSemaphore *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xTicksToWait);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex);
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t xMutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_STUB_SEMPHR_H
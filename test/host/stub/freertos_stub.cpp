@@ -0,0 +1,89 @@
+// Definitions for the FreeRTOS stand-in in freertos/.
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+struct HostTask {
+    TaskFunction_t function;
+    void *parameters;
+};
+
+struct HostSemaphore {
+    std::recursive_mutex mutex;
+    std::atomic<TaskHandle_t> holder{nullptr};
+    uint32_t depth = 0;
+};
+
+// threads that were not started by xTaskCreatePinnedToCore, such as main(),
+// are tasks of their own too
+static thread_local HostTask t_thread;
+static thread_local HostTask *t_currentTask;
+
+extern "C" {
+
+void vPortEnterCritical(portMUX_TYPE *mux) {
+    while (__atomic_exchange_n(&mux->locked, 1, __ATOMIC_ACQUIRE)) {
+        std::this_thread::yield();
+    }
+}
+
+void vPortExitCritical(portMUX_TYPE *mux) {
+    __atomic_store_n(&mux->locked, 0, __ATOMIC_RELEASE);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) {
+    return new HostSemaphore;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xTicksToWait) {
+    (void)xTicksToWait;
+    xMutex->mutex.lock();
+    if (xMutex->depth++ == 0) {
+        xMutex->holder = xTaskGetCurrentTaskHandle();
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex) {
+    if (--xMutex->depth == 0) {
+        xMutex->holder = nullptr;
+    }
+    xMutex->mutex.unlock();
+    return pdTRUE;
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t xMutex) {
+    return xMutex->holder;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pvCreatedTask, BaseType_t xCoreID) {
+    (void)pcName;
+    (void)usStackDepth;
+    (void)uxPriority;
+    (void)xCoreID;
+    // the task runs until the process exits, as FreeRTOS tasks that never
+    // delete themselves do
+    auto task = new HostTask{ pvTaskCode, pvParameters };
+    if (pvCreatedTask) {
+        *pvCreatedTask = task;
+    }
+    std::thread([task]() {
+        t_currentTask = task;
+        task->function(task->parameters);
+    }).detach();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return t_currentTask ? t_currentTask : &t_thread;
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
+}
+
+}
@@ -0,0 +1,278 @@
+// Minimal stand-in for the LVGL 9.1 API used by ui/ and eez-flow.cpp, so the
+// host tests build without an LVGL port. Objects are plain allocations that
+// only track their parent, children, flags and states; drawing, layout,
+// styles and animations do nothing. Definitions are in ../lvgl_stub.c.
+#ifndef HOST_STUB_LVGL_H
+#define HOST_STUB_LVGL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define LVGL_VERSION_MAJOR 9
+#define LVGL_VERSION_MINOR 1
+
+#define LV_OS_NONE 0
+#ifndef LV_USE_OS
+#define LV_USE_OS LV_OS_NONE
+#endif
+
+#define LV_USE_QRCODE 1
+
+#define LV_LOG_ERROR(...) do {} while (0)
+#define LV_LOG_WARN(...) do {} while (0)
+#define LV_LOG_INFO(...) do {} while (0)
+#define LV_LOG_USER(...) do {} while (0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _lv_obj_t lv_obj_t;
+typedef struct _lv_group_t lv_group_t;
+typedef struct _lv_indev_t lv_indev_t;
+typedef struct _lv_style_t lv_style_t;
+typedef struct _lv_obj_class_t lv_obj_class_t;
+typedef struct _lv_display_t lv_display_t;
+typedef lv_display_t lv_disp_t;
+typedef struct _lv_theme_t lv_theme_t;
+typedef struct _lv_font_t lv_font_t;
+typedef struct _lv_roller_t lv_roller_t;
+
+typedef int lv_event_code_t;
+typedef struct _lv_event_t {
+    void *current_target;
+    void *original_target;
+    lv_event_code_t code;
+    void *user_data;
+    void *param;
+} lv_event_t;
+typedef void (*lv_event_cb_t)(lv_event_t *e);
+
+typedef uint32_t lv_state_t;
+typedef uint32_t lv_obj_flag_t;
+typedef uint8_t lv_opa_t;
+typedef int32_t lv_coord_t;
+typedef uintptr_t lv_uintptr_t;
+typedef int32_t lv_style_selector_t;
+typedef int lv_dir_t;
+typedef int lv_anim_enable_t;
+typedef int lv_roller_mode_t;
+typedef int lv_screen_load_anim_t;
+typedef lv_screen_load_anim_t lv_scr_load_anim_t;
+typedef uint32_t lv_buttonmatrix_ctrl_t;
+typedef lv_buttonmatrix_ctrl_t lv_btnmatrix_ctrl_t;
+typedef uint32_t lv_color_t;
+typedef int lv_palette_t;
+
+typedef struct {
+    uint16_t year;
+    int8_t month;
+    int8_t day;
+} lv_calendar_date_t;
+
+typedef struct {
+    size_t total_size;
+    size_t free_cnt;
+    size_t free_size;
+    size_t free_biggest_size;
+    size_t used_cnt;
+    size_t max_used;
+    uint8_t used_pct;
+    uint8_t frag_pct;
+} lv_mem_monitor_t;
+
+typedef struct {
+    uint32_t header;
+    uint32_t data_size;
+    const uint8_t *data;
+} lv_image_dsc_t;
+typedef lv_image_dsc_t lv_img_dsc_t;
+
+typedef struct _lv_anim_t lv_anim_t;
+typedef void (*lv_anim_exec_xcb_t)(void *var, int32_t value);
+typedef int32_t (*lv_anim_get_value_cb_t)(lv_anim_t *a);
+typedef int32_t (*lv_anim_path_cb_t)(const lv_anim_t *a);
+struct _lv_anim_t {
+    void *var;
+    void *user_data;
+    lv_anim_exec_xcb_t exec_cb;
+    lv_anim_get_value_cb_t get_value_cb;
+    lv_anim_path_cb_t path_cb;
+    int32_t start_value;
+    int32_t end_value;
+    uint32_t duration;
+    uint32_t delay;
+};
+
+typedef union {
+    int32_t num;
+    const void *ptr;
+    lv_color_t color;
+} lv_style_value_t;
+typedef uint8_t lv_style_prop_t;
+typedef uint8_t lv_style_res_t;
+
+enum { LV_ANIM_OFF, LV_ANIM_ON };
+enum { LV_DIR_NONE = 0 };
+enum {
+    LV_EVENT_ALL = 0,
+    LV_EVENT_PRESSED,
+    LV_EVENT_PRESSING,
+    LV_EVENT_CLICKED,
+    LV_EVENT_SCROLL,
+    LV_EVENT_GESTURE,
+    LV_EVENT_KEY,
+    LV_EVENT_ROTARY,
+    LV_EVENT_VALUE_CHANGED,
+    LV_EVENT_SCREEN_UNLOADED,
+    LV_EVENT_SCREEN_LOADED,
+    LV_EVENT_DELETE,
+    LV_EVENT_LAST
+};
+enum { LV_OBJ_FLAG_HIDDEN = 1 << 0, LV_OBJ_FLAG_CLICKABLE = 1 << 1 };
+enum { LV_STATE_DEFAULT = 0, LV_STATE_CHECKED = 1 << 0, LV_STATE_DISABLED = 1 << 7 };
+enum { LV_PART_MAIN = 0 };
+enum { LV_SCR_LOAD_ANIM_NONE = 0, LV_SCR_LOAD_ANIM_FADE_IN = 9 };
+enum { LV_PALETTE_RED = 0, LV_PALETTE_BLUE = 5 };
+enum { LV_STYLE_RES_NOT_FOUND = 0, LV_STYLE_RES_FOUND = 1 };
+enum { LV_STYLE_X = 1, LV_STYLE_Y, LV_STYLE_WIDTH, LV_STYLE_HEIGHT, LV_STYLE_OPA };
+
+#define LV_SIZE_CONTENT 0x7ff
+#define LV_FONT_DEFAULT ((const lv_font_t *)0)
+
+extern const lv_obj_class_t lv_buttonmatrix_class;
+#define lv_btnmatrix_class lv_buttonmatrix_class
+
+// Host only: while set, lv_malloc fails, to test out-of-memory paths.
+extern bool lv_stub_malloc_fails;
+// Host only: counts the calls that change an object's flags, state, geometry or text.
+extern uint32_t lv_stub_num_obj_writes;
+void *lv_malloc(size_t size);
+void lv_free(void *data);
+void lv_mem_monitor(lv_mem_monitor_t *mon_p);
+#define lv_mem_alloc lv_malloc
+#define lv_mem_free lv_free
+
+uint32_t lv_tick_get(void);
+uint32_t lv_tick_elaps(uint32_t prev_tick);
+
+lv_display_t *lv_disp_get_default(void);
+void lv_disp_set_theme(lv_display_t *disp, lv_theme_t *theme);
+lv_theme_t *lv_theme_default_init(lv_display_t *disp, lv_color_t color_primary, lv_color_t color_secondary, bool dark, const lv_font_t *font);
+lv_color_t lv_palette_main(lv_palette_t p);
+
+lv_obj_t *lv_obj_create(lv_obj_t *parent);
+void lv_obj_delete(lv_obj_t *obj);
+void lv_obj_delete_async(lv_obj_t *obj);
+#define lv_obj_del lv_obj_delete
+lv_obj_t *lv_obj_get_screen(const lv_obj_t *obj);
+bool lv_obj_check_type(const lv_obj_t *obj, const lv_obj_class_t *class_p);
+void lv_obj_add_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb, lv_event_code_t filter, void *user_data);
+bool lv_obj_remove_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb);
+void lv_obj_add_flag(lv_obj_t *obj, lv_obj_flag_t f);
+void lv_obj_clear_flag(lv_obj_t *obj, lv_obj_flag_t f);
+bool lv_obj_has_flag(const lv_obj_t *obj, lv_obj_flag_t f);
+void lv_obj_add_state(lv_obj_t *obj, lv_state_t state);
+void lv_obj_clear_state(lv_obj_t *obj, lv_state_t state);
+bool lv_obj_has_state(const lv_obj_t *obj, lv_state_t state);
+void lv_obj_set_pos(lv_obj_t *obj, int32_t x, int32_t y);
+void lv_obj_set_size(lv_obj_t *obj, int32_t w, int32_t h);
+void lv_obj_set_x(lv_obj_t *obj, int32_t x);
+void lv_obj_set_y(lv_obj_t *obj, int32_t y);
+void lv_obj_set_width(lv_obj_t *obj, int32_t w);
+void lv_obj_set_height(lv_obj_t *obj, int32_t h);
+int32_t lv_obj_get_x(const lv_obj_t *obj);
+int32_t lv_obj_get_y(const lv_obj_t *obj);
+int32_t lv_obj_get_x_aligned(const lv_obj_t *obj);
+int32_t lv_obj_get_y_aligned(const lv_obj_t *obj);
+int32_t lv_obj_get_width(const lv_obj_t *obj);
+int32_t lv_obj_get_height(const lv_obj_t *obj);
+void lv_obj_update_layout(const lv_obj_t *obj);
+void lv_obj_set_style_opa(lv_obj_t *obj, lv_opa_t value, lv_style_selector_t selector);
+lv_opa_t lv_obj_get_style_opa(const lv_obj_t *obj, uint32_t part);
+void lv_obj_add_style(lv_obj_t *obj, lv_style_t *style, lv_style_selector_t selector);
+void lv_obj_remove_style(lv_obj_t *obj, lv_style_t *style, lv_style_selector_t selector);
+lv_style_res_t lv_obj_get_local_style_prop(const lv_obj_t *obj, lv_style_prop_t prop, lv_style_value_t *value, lv_style_selector_t selector);
+
+lv_obj_t *lv_screen_active(void);
+#define lv_scr_act lv_screen_active
+void lv_screen_load_anim(lv_obj_t *scr, lv_screen_load_anim_t anim_type, uint32_t time, uint32_t delay, bool auto_del);
+#define lv_scr_load_anim lv_screen_load_anim
+
+lv_event_code_t lv_event_get_code(lv_event_t *e);
+void *lv_event_get_current_target(lv_event_t *e);
+void *lv_event_get_target(lv_event_t *e);
+void *lv_event_get_user_data(lv_event_t *e);
+void *lv_event_get_param(lv_event_t *e);
+int32_t lv_event_get_rotary_diff(lv_event_t *e);
+
+lv_indev_t *lv_indev_active(void);
+#define lv_indev_get_act lv_indev_active
+lv_dir_t lv_indev_get_gesture_dir(const lv_indev_t *indev);
+void lv_indev_wait_release(lv_indev_t *indev);
+
+void lv_group_focus_obj(lv_obj_t *obj);
+void lv_group_focus_next(lv_group_t *group);
+void lv_group_focus_prev(lv_group_t *group);
+void lv_group_focus_freeze(lv_group_t *group, bool en);
+lv_obj_t *lv_group_get_focused(const lv_group_t *group);
+void lv_group_set_editing(lv_group_t *group, bool edit);
+void lv_group_set_wrap(lv_group_t *group, bool en);
+
+void lv_anim_init(lv_anim_t *a);
+void lv_anim_set_var(lv_anim_t *a, void *var);
+void lv_anim_set_user_data(lv_anim_t *a, void *user_data);
+void lv_anim_set_exec_cb(lv_anim_t *a, lv_anim_exec_xcb_t exec_cb);
+void lv_anim_set_get_value_cb(lv_anim_t *a, lv_anim_get_value_cb_t get_value_cb);
+void lv_anim_set_path_cb(lv_anim_t *a, lv_anim_path_cb_t path_cb);
+void lv_anim_set_values(lv_anim_t *a, int32_t start, int32_t end);
+void lv_anim_set_time(lv_anim_t *a, uint32_t duration);
+void lv_anim_set_delay(lv_anim_t *a, uint32_t delay);
+void lv_anim_set_early_apply(lv_anim_t *a, bool en);
+lv_anim_t *lv_anim_start(const lv_anim_t *a);
+uint16_t lv_anim_count_running(void);
+int32_t lv_anim_path_linear(const lv_anim_t *a);
+int32_t lv_anim_path_ease_in(const lv_anim_t *a);
+int32_t lv_anim_path_ease_out(const lv_anim_t *a);
+int32_t lv_anim_path_ease_in_out(const lv_anim_t *a);
+int32_t lv_anim_path_overshoot(const lv_anim_t *a);
+int32_t lv_anim_path_bounce(const lv_anim_t *a);
+
+lv_obj_t *lv_label_create(lv_obj_t *parent);
+void lv_label_set_text(lv_obj_t *obj, const char *text);
+const char *lv_label_get_text(const lv_obj_t *obj);
+void lv_img_set_src(lv_obj_t *obj, const void *src);
+const void *lv_img_get_src(lv_obj_t *obj);
+void lv_img_set_angle(lv_obj_t *obj, int32_t angle);
+int32_t lv_img_get_angle(lv_obj_t *obj);
+void lv_img_set_zoom(lv_obj_t *obj, int32_t zoom);
+int32_t lv_img_get_zoom(lv_obj_t *obj);
+void lv_arc_set_value(lv_obj_t *obj, int32_t value);
+void lv_bar_set_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim);
+void lv_slider_set_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim);
+void lv_slider_set_left_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim);
+void lv_slider_set_range(lv_obj_t *obj, int32_t min, int32_t max);
+void lv_dropdown_set_selected(lv_obj_t *obj, uint32_t sel_opt);
+lv_obj_t *lv_roller_create(lv_obj_t *parent);
+void lv_roller_set_options(lv_obj_t *obj, const char *options, lv_roller_mode_t mode);
+const char *lv_roller_get_options(const lv_obj_t *obj);
+void lv_roller_set_selected(lv_obj_t *obj, uint32_t sel_opt, lv_anim_enable_t anim);
+uint32_t lv_roller_get_selected(const lv_obj_t *obj);
+uint32_t lv_roller_get_option_count(const lv_obj_t *obj);
+#define lv_roller_get_option_cnt lv_roller_get_option_count
+void lv_keyboard_set_textarea(lv_obj_t *kb, lv_obj_t *ta);
+void lv_buttonmatrix_set_button_ctrl(lv_obj_t *obj, uint32_t btn_id, lv_buttonmatrix_ctrl_t ctrl);
+void lv_buttonmatrix_clear_button_ctrl(lv_obj_t *obj, uint32_t btn_id, lv_buttonmatrix_ctrl_t ctrl);
+#define lv_btnmatrix_set_btn_ctrl lv_buttonmatrix_set_button_ctrl
+void lv_calendar_set_today_date(lv_obj_t *obj, uint32_t year, uint32_t month, uint32_t day);
+void lv_calendar_set_showed_date(lv_obj_t *obj, uint32_t year, uint32_t month);
+void lv_calendar_set_highlighted_dates(lv_obj_t *obj, lv_calendar_date_t highlighted[], size_t date_num);
+int lv_calendar_get_pressed_date(const lv_obj_t *calendar, lv_calendar_date_t *date);
+void lv_qrcode_update(lv_obj_t *obj, const void *data, uint32_t data_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_STUB_LVGL_H
@@ -0,0 +1,586 @@
+// Definitions for the LVGL stand-in in lvgl/lvgl.h.
+#include "lvgl/lvgl.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct _lv_obj_t {
+    lv_obj_t *parent;
+    lv_obj_t *first_child;
+    lv_obj_t *next_sibling;
+    lv_obj_flag_t flags;
+    lv_state_t state;
+    int32_t x, y, w, h;
+    const char *text;
+    const char *options;
+    uint32_t selected;
+    lv_event_cb_t delete_cb;
+    void *delete_user_data;
+};
+
+struct _lv_obj_class_t {
+    int unused;
+};
+
+const lv_obj_class_t lv_buttonmatrix_class;
+
+static lv_obj_t *g_activeScreen;
+
+bool lv_stub_malloc_fails;
+uint32_t lv_stub_num_obj_writes;
+
+void *lv_malloc(size_t size) {
+    if (lv_stub_malloc_fails) {
+        return NULL;
+    }
+    return malloc(size);
+}
+
+void lv_free(void *data) {
+    free(data);
+}
+
+void lv_mem_monitor(lv_mem_monitor_t *mon_p) {
+    memset(mon_p, 0, sizeof(*mon_p));
+}
+
+uint32_t lv_tick_get(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+uint32_t lv_tick_elaps(uint32_t prev_tick) {
+    return lv_tick_get() - prev_tick;
+}
+
+lv_display_t *lv_disp_get_default(void) {
+    return NULL;
+}
+
+void lv_disp_set_theme(lv_display_t *disp, lv_theme_t *theme) {
+    (void)disp;
+    (void)theme;
+}
+
+lv_theme_t *lv_theme_default_init(lv_display_t *disp, lv_color_t color_primary, lv_color_t color_secondary, bool dark, const lv_font_t *font) {
+    (void)disp;
+    (void)color_primary;
+    (void)color_secondary;
+    (void)dark;
+    (void)font;
+    return NULL;
+}
+
+lv_color_t lv_palette_main(lv_palette_t p) {
+    return (lv_color_t)p;
+}
+
+lv_obj_t *lv_obj_create(lv_obj_t *parent) {
+    // not calloc, which skips glibc's per-thread cache, so a new object can get the address
+    // of the one deleted just before, as it does with LVGL's allocator
+    lv_obj_t *obj = (lv_obj_t *)malloc(sizeof(lv_obj_t));
+    memset(obj, 0, sizeof(lv_obj_t));
+    obj->parent = parent;
+    if (parent) {
+        obj->next_sibling = parent->first_child;
+        parent->first_child = obj;
+    }
+    return obj;
+}
+
+void lv_obj_delete(lv_obj_t *obj) {
+    while (obj->first_child) {
+        lv_obj_delete(obj->first_child);
+    }
+    if (obj->delete_cb) {
+        lv_event_t e = { obj, obj, LV_EVENT_DELETE, obj->delete_user_data, NULL };
+        obj->delete_cb(&e);
+    }
+    if (obj->parent) {
+        lv_obj_t **link = &obj->parent->first_child;
+        while (*link != obj) {
+            link = &(*link)->next_sibling;
+        }
+        *link = obj->next_sibling;
+    }
+    if (g_activeScreen == obj) {
+        g_activeScreen = NULL;
+    }
+    free((void *)obj->options);
+    free((void *)obj->text);
+    free(obj);
+}
+
+void lv_obj_delete_async(lv_obj_t *obj) {
+    // there is no timer handler to defer to on the host
+    lv_obj_delete(obj);
+}
+
+lv_obj_t *lv_obj_get_screen(const lv_obj_t *obj) {
+    while (obj->parent) {
+        obj = obj->parent;
+    }
+    return (lv_obj_t *)obj;
+}
+
+bool lv_obj_check_type(const lv_obj_t *obj, const lv_obj_class_t *class_p) {
+    (void)obj;
+    (void)class_p;
+    return false;
+}
+
+void lv_obj_add_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb, lv_event_code_t filter, void *user_data) {
+    // only delete callbacks are ever sent on the host
+    if (filter == LV_EVENT_DELETE) {
+        obj->delete_cb = event_cb;
+        obj->delete_user_data = user_data;
+    }
+}
+
+bool lv_obj_remove_event_cb(lv_obj_t *obj, lv_event_cb_t event_cb) {
+    if (obj->delete_cb != event_cb) {
+        return false;
+    }
+    obj->delete_cb = NULL;
+    obj->delete_user_data = NULL;
+    return true;
+}
+
+void lv_obj_add_flag(lv_obj_t *obj, lv_obj_flag_t f) {
+    lv_stub_num_obj_writes++;
+    obj->flags |= f;
+}
+
+void lv_obj_clear_flag(lv_obj_t *obj, lv_obj_flag_t f) {
+    lv_stub_num_obj_writes++;
+    obj->flags &= ~f;
+}
+
+bool lv_obj_has_flag(const lv_obj_t *obj, lv_obj_flag_t f) {
+    return (obj->flags & f) == f;
+}
+
+void lv_obj_add_state(lv_obj_t *obj, lv_state_t state) {
+    lv_stub_num_obj_writes++;
+    obj->state |= state;
+}
+
+void lv_obj_clear_state(lv_obj_t *obj, lv_state_t state) {
+    lv_stub_num_obj_writes++;
+    obj->state &= ~state;
+}
+
+bool lv_obj_has_state(const lv_obj_t *obj, lv_state_t state) {
+    return (obj->state & state) != 0;
+}
+
+void lv_obj_set_pos(lv_obj_t *obj, int32_t x, int32_t y) {
+    obj->x = x;
+    obj->y = y;
+}
+
+void lv_obj_set_size(lv_obj_t *obj, int32_t w, int32_t h) {
+    obj->w = w;
+    obj->h = h;
+}
+
+void lv_obj_set_x(lv_obj_t *obj, int32_t x) {
+    lv_stub_num_obj_writes++;
+    obj->x = x;
+}
+
+void lv_obj_set_y(lv_obj_t *obj, int32_t y) {
+    lv_stub_num_obj_writes++;
+    obj->y = y;
+}
+
+void lv_obj_set_width(lv_obj_t *obj, int32_t w) {
+    lv_stub_num_obj_writes++;
+    obj->w = w;
+}
+
+void lv_obj_set_height(lv_obj_t *obj, int32_t h) {
+    lv_stub_num_obj_writes++;
+    obj->h = h;
+}
+
+int32_t lv_obj_get_x(const lv_obj_t *obj) {
+    return obj->x;
+}
+
+int32_t lv_obj_get_y(const lv_obj_t *obj) {
+    return obj->y;
+}
+
+int32_t lv_obj_get_x_aligned(const lv_obj_t *obj) {
+    return obj->x;
+}
+
+int32_t lv_obj_get_y_aligned(const lv_obj_t *obj) {
+    return obj->y;
+}
+
+int32_t lv_obj_get_width(const lv_obj_t *obj) {
+    return obj->w;
+}
+
+int32_t lv_obj_get_height(const lv_obj_t *obj) {
+    return obj->h;
+}
+
+void lv_obj_update_layout(const lv_obj_t *obj) {
+    (void)obj;
+}
+
+void lv_obj_set_style_opa(lv_obj_t *obj, lv_opa_t value, lv_style_selector_t selector) {
+    (void)obj;
+    (void)value;
+    (void)selector;
+}
+
+lv_opa_t lv_obj_get_style_opa(const lv_obj_t *obj, uint32_t part) {
+    (void)obj;
+    (void)part;
+    return 255;
+}
+
+void lv_obj_add_style(lv_obj_t *obj, lv_style_t *style, lv_style_selector_t selector) {
+    (void)obj;
+    (void)style;
+    (void)selector;
+}
+
+void lv_obj_remove_style(lv_obj_t *obj, lv_style_t *style, lv_style_selector_t selector) {
+    (void)obj;
+    (void)style;
+    (void)selector;
+}
+
+lv_style_res_t lv_obj_get_local_style_prop(const lv_obj_t *obj, lv_style_prop_t prop, lv_style_value_t *value, lv_style_selector_t selector) {
+    (void)obj;
+    (void)prop;
+    (void)value;
+    (void)selector;
+    return LV_STYLE_RES_NOT_FOUND;
+}
+
+lv_obj_t *lv_screen_active(void) {
+    return g_activeScreen;
+}
+
+void lv_screen_load_anim(lv_obj_t *scr, lv_screen_load_anim_t anim_type, uint32_t time, uint32_t delay, bool auto_del) {
+    (void)anim_type;
+    (void)time;
+    (void)delay;
+    (void)auto_del;
+    g_activeScreen = scr;
+}
+
+lv_event_code_t lv_event_get_code(lv_event_t *e) {
+    return e->code;
+}
+
+void *lv_event_get_current_target(lv_event_t *e) {
+    return e->current_target;
+}
+
+void *lv_event_get_target(lv_event_t *e) {
+    return e->original_target;
+}
+
+void *lv_event_get_user_data(lv_event_t *e) {
+    return e->user_data;
+}
+
+void *lv_event_get_param(lv_event_t *e) {
+    return e->param;
+}
+
+int32_t lv_event_get_rotary_diff(lv_event_t *e) {
+    (void)e;
+    return 0;
+}
+
+lv_indev_t *lv_indev_active(void) {
+    return NULL;
+}
+
+lv_dir_t lv_indev_get_gesture_dir(const lv_indev_t *indev) {
+    (void)indev;
+    return LV_DIR_NONE;
+}
+
+void lv_indev_wait_release(lv_indev_t *indev) {
+    (void)indev;
+}
+
+void lv_group_focus_obj(lv_obj_t *obj) {
+    (void)obj;
+}
+
+void lv_group_focus_next(lv_group_t *group) {
+    (void)group;
+}
+
+void lv_group_focus_prev(lv_group_t *group) {
+    (void)group;
+}
+
+void lv_group_focus_freeze(lv_group_t *group, bool en) {
+    (void)group;
+    (void)en;
+}
+
+lv_obj_t *lv_group_get_focused(const lv_group_t *group) {
+    (void)group;
+    return NULL;
+}
+
+void lv_group_set_editing(lv_group_t *group, bool edit) {
+    (void)group;
+    (void)edit;
+}
+
+void lv_group_set_wrap(lv_group_t *group, bool en) {
+    (void)group;
+    (void)en;
+}
+
+void lv_anim_init(lv_anim_t *a) {
+    memset(a, 0, sizeof(*a));
+}
+
+void lv_anim_set_var(lv_anim_t *a, void *var) {
+    a->var = var;
+}
+
+void lv_anim_set_user_data(lv_anim_t *a, void *user_data) {
+    a->user_data = user_data;
+}
+
+void lv_anim_set_exec_cb(lv_anim_t *a, lv_anim_exec_xcb_t exec_cb) {
+    a->exec_cb = exec_cb;
+}
+
+void lv_anim_set_get_value_cb(lv_anim_t *a, lv_anim_get_value_cb_t get_value_cb) {
+    a->get_value_cb = get_value_cb;
+}
+
+void lv_anim_set_path_cb(lv_anim_t *a, lv_anim_path_cb_t path_cb) {
+    a->path_cb = path_cb;
+}
+
+void lv_anim_set_values(lv_anim_t *a, int32_t start, int32_t end) {
+    a->start_value = start;
+    a->end_value = end;
+}
+
+void lv_anim_set_time(lv_anim_t *a, uint32_t duration) {
+    a->duration = duration;
+}
+
+void lv_anim_set_delay(lv_anim_t *a, uint32_t delay) {
+    a->delay = delay;
+}
+
+void lv_anim_set_early_apply(lv_anim_t *a, bool en) {
+    (void)a;
+    (void)en;
+}
+
+lv_anim_t *lv_anim_start(const lv_anim_t *a) {
+    // animations complete immediately
+    if (a->exec_cb) {
+        a->exec_cb(a->var, a->end_value);
+    }
+    return NULL;
+}
+
+uint16_t lv_anim_count_running(void) {
+    return 0;
+}
+
+int32_t lv_anim_path_linear(const lv_anim_t *a) {
+    return a->end_value;
+}
+
+int32_t lv_anim_path_ease_in(const lv_anim_t *a) {
+    return a->end_value;
+}
+
+int32_t lv_anim_path_ease_out(const lv_anim_t *a) {
+    return a->end_value;
+}
+
+int32_t lv_anim_path_ease_in_out(const lv_anim_t *a) {
+    return a->end_value;
+}
+
+int32_t lv_anim_path_overshoot(const lv_anim_t *a) {
+    return a->end_value;
+}
+
+int32_t lv_anim_path_bounce(const lv_anim_t *a) {
+    return a->end_value;
+}
+
+lv_obj_t *lv_label_create(lv_obj_t *parent) {
+    return lv_obj_create(parent);
+}
+
+void lv_label_set_text(lv_obj_t *obj, const char *text) {
+    lv_stub_num_obj_writes++;
+    // LVGL keeps its own copy of the text
+    char *copy = strdup(text);
+    free((void *)obj->text);
+    obj->text = copy;
+}
+
+const char *lv_label_get_text(const lv_obj_t *obj) {
+    return obj->text ? obj->text : "";
+}
+
+void lv_img_set_src(lv_obj_t *obj, const void *src) {
+    (void)obj;
+    (void)src;
+}
+
+const void *lv_img_get_src(lv_obj_t *obj) {
+    (void)obj;
+    return NULL;
+}
+
+void lv_img_set_angle(lv_obj_t *obj, int32_t angle) {
+    (void)obj;
+    (void)angle;
+}
+
+int32_t lv_img_get_angle(lv_obj_t *obj) {
+    (void)obj;
+    return 0;
+}
+
+void lv_img_set_zoom(lv_obj_t *obj, int32_t zoom) {
+    (void)obj;
+    (void)zoom;
+}
+
+int32_t lv_img_get_zoom(lv_obj_t *obj) {
+    (void)obj;
+    return 256;
+}
+
+void lv_arc_set_value(lv_obj_t *obj, int32_t value) {
+    (void)obj;
+    (void)value;
+}
+
+void lv_bar_set_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim) {
+    (void)obj;
+    (void)value;
+    (void)anim;
+}
+
+void lv_slider_set_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim) {
+    (void)obj;
+    (void)value;
+    (void)anim;
+}
+
+void lv_slider_set_left_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim) {
+    (void)obj;
+    (void)value;
+    (void)anim;
+}
+
+void lv_slider_set_range(lv_obj_t *obj, int32_t min, int32_t max) {
+    (void)obj;
+    (void)min;
+    (void)max;
+}
+
+void lv_dropdown_set_selected(lv_obj_t *obj, uint32_t sel_opt) {
+    obj->selected = sel_opt;
+}
+
+lv_obj_t *lv_roller_create(lv_obj_t *parent) {
+    return lv_obj_create(parent);
+}
+
+void lv_roller_set_options(lv_obj_t *obj, const char *options, lv_roller_mode_t mode) {
+    (void)mode;
+    free((void *)obj->options);
+    obj->options = strdup(options);
+}
+
+const char *lv_roller_get_options(const lv_obj_t *obj) {
+    return obj->options ? obj->options : "";
+}
+
+void lv_roller_set_selected(lv_obj_t *obj, uint32_t sel_opt, lv_anim_enable_t anim) {
+    (void)anim;
+    obj->selected = sel_opt;
+}
+
+uint32_t lv_roller_get_selected(const lv_obj_t *obj) {
+    return obj->selected;
+}
+
+uint32_t lv_roller_get_option_count(const lv_obj_t *obj) {
+    uint32_t count = 1;
+    for (const char *p = lv_roller_get_options(obj); *p; p++) {
+        if (*p == '\n') {
+            count++;
+        }
+    }
+    return count;
+}
+
+void lv_keyboard_set_textarea(lv_obj_t *kb, lv_obj_t *ta) {
+    (void)kb;
+    (void)ta;
+}
+
+void lv_buttonmatrix_set_button_ctrl(lv_obj_t *obj, uint32_t btn_id, lv_buttonmatrix_ctrl_t ctrl) {
+    (void)obj;
+    (void)btn_id;
+    (void)ctrl;
+}
+
+void lv_buttonmatrix_clear_button_ctrl(lv_obj_t *obj, uint32_t btn_id, lv_buttonmatrix_ctrl_t ctrl) {
+    (void)obj;
+    (void)btn_id;
+    (void)ctrl;
+}
+
+void lv_calendar_set_today_date(lv_obj_t *obj, uint32_t year, uint32_t month, uint32_t day) {
+    (void)obj;
+    (void)year;
+    (void)month;
+    (void)day;
+}
+
+void lv_calendar_set_showed_date(lv_obj_t *obj, uint32_t year, uint32_t month) {
+    (void)obj;
+    (void)year;
+    (void)month;
+}
+
+void lv_calendar_set_highlighted_dates(lv_obj_t *obj, lv_calendar_date_t highlighted[], size_t date_num) {
+    (void)obj;
+    (void)highlighted;
+    (void)date_num;
+}
+
+int lv_calendar_get_pressed_date(const lv_obj_t *calendar, lv_calendar_date_t *date) {
+    (void)calendar;
+    (void)date;
+    return -1;
+}
+
+void lv_qrcode_update(lv_obj_t *obj, const void *data, uint32_t data_len) {
+    (void)obj;
+    (void)data;
+    (void)data_len;
+}
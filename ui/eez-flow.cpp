@@ -29,6 +29,7 @@ namespace gui {
 #endif
 void executeActionFunction(int actionId) {
 #if defined(EEZ_FOR_LVGL)
+    eez::flow::flushLvglWrites();
 	eez::flow::executeLvglActionHook(actionId - 1);
 #else
     g_actionExecFunctions[actionId]();
@@ -2112,6 +2113,26 @@ static void PROPERTY_REF_value_to_text(const Value &value, char *text, int count
     snprintf(text, count, "property-ref (flowState=%p, component=%d, property=%d)",
         (void *)value.getPropertyRef()->flowState, value.getPropertyRef()->componentIndex, value.getPropertyRef()->propertyIndex);
 }
+static bool compare_PACKED_ARRAY_REF_value(const Value &a, const Value &b) {
+    return a.type == b.type && a.refValue == b.refValue;
+}
+static void PACKED_ARRAY_REF_value_to_text(const Value &value, char *text, int count) {
+    auto packedArray = value.getPackedArray();
+    text[0] = 0;
+    int position = 0;
+    for (uint32_t elementIndex = 0; elementIndex < packedArray->arraySize && position < count - 1; elementIndex++) {
+        if (elementIndex > 0) {
+            stringAppendString(text + position, count - position, ", ");
+            position += strlen(text + position);
+        }
+        packedArray->get(elementIndex).toText(text + position, count - position);
+        position += strlen(text + position);
+    }
+}
+static const char *PACKED_ARRAY_REF_value_type_name(const Value &value) {
+    EEZ_UNUSED(value);
+    return "array";
+}
 static bool compare_DATE_value(const Value &a, const Value &b) {
     return a.type == b.type && a.doubleValue == b.doubleValue;
 }
@@ -2341,7 +2362,7 @@ ValueTypeNameFunction g_valueTypeNames[] = {
 #undef VALUE_TYPE
 ArrayValueRef::~ArrayValueRef() {
     eez::flow::onArrayValueFree(&arrayValue);
-    for (uint32_t i = 1; i < arrayValue.arraySize; i++) {
+    for (uint32_t i = 1; i < capacity; i++) {
         (arrayValue.values + i)->~Value();
     }
 }
@@ -2706,6 +2727,9 @@ bool Value::toBool(int *err) const {
 		auto array = getArray();
         return array->arraySize != 0;
 	}
+    if (isPackedArray()) {
+        return getPackedArray()->arraySize != 0;
+    }
     if (isJson()) {
         return int32Value != 0;
     }
@@ -2813,6 +2837,8 @@ Value Value::makeArrayRef(int arraySize, int arrayType, uint32_t id) {
 		return Value(0, VALUE_TYPE_NULL);
 	}
     ArrayValueRef *arrayRef = new (ptr) ArrayValueRef;
+    arrayRef->capacity = arraySize > 0 ? arraySize : 1;
+    arrayRef->cowShared = false;
     arrayRef->arrayValue.arraySize = arraySize;
     arrayRef->arrayValue.arrayType = arrayType;
     for (int i = 1; i < arraySize; i++) {
@@ -2896,9 +2922,107 @@ Value Value::makeBlobRef(const uint8_t *blob1, uint32_t len1, const uint8_t *blo
     value.refValue = blobRef;
 	return value;
 }
+uint32_t PackedArrayRef::getElementSize(uint32_t arrayType) {
+    if (arrayType == flow::defs_v3::ARRAY_TYPE_INTEGER || arrayType == flow::defs_v3::ARRAY_TYPE_FLOAT) {
+        return 4;
+    }
+    if (arrayType == flow::defs_v3::ARRAY_TYPE_DOUBLE) {
+        return 8;
+    }
+    return 0;
+}
+bool PackedArrayRef::reserve(uint32_t minCapacity) {
+    if (minCapacity <= capacity) {
+        return true;
+    }
+    uint32_t newCapacity = capacity < 4 ? 4 : 2 * capacity;
+    if (newCapacity < minCapacity) {
+        newCapacity = minCapacity;
+    }
+    auto newData = (uint8_t *)alloc(newCapacity * elementSize, 0x2f7c4b19);
+    if (newData == nullptr) {
+        return false;
+    }
+    if (data) {
+        memcpy(newData, data, arraySize * elementSize);
+        eez::free(data);
+    }
+    data = newData;
+    capacity = newCapacity;
+    return true;
+}
+Value PackedArrayRef::get(uint32_t elementIndex) const {
+    auto src = data + elementIndex * elementSize;
+    if (arrayType == flow::defs_v3::ARRAY_TYPE_FLOAT) {
+        float floatValue;
+        memcpy(&floatValue, src, sizeof(float));
+        return Value(floatValue, VALUE_TYPE_FLOAT);
+    }
+    if (arrayType == flow::defs_v3::ARRAY_TYPE_DOUBLE) {
+        double doubleValue;
+        memcpy(&doubleValue, src, sizeof(double));
+        return Value(doubleValue, VALUE_TYPE_DOUBLE);
+    }
+    int32_t intValue;
+    memcpy(&intValue, src, sizeof(int32_t));
+    return Value((int)intValue, VALUE_TYPE_INT32);
+}
+bool PackedArrayRef::pack(const Value &value, uint8_t *dst) const {
+    int err;
+    if (arrayType == flow::defs_v3::ARRAY_TYPE_FLOAT) {
+        float floatValue = value.toFloat(&err);
+        if (err) {
+            return false;
+        }
+        memcpy(dst, &floatValue, sizeof(float));
+    } else if (arrayType == flow::defs_v3::ARRAY_TYPE_DOUBLE) {
+        double doubleValue = value.toDouble(&err);
+        if (err) {
+            return false;
+        }
+        memcpy(dst, &doubleValue, sizeof(double));
+    } else {
+        int32_t intValue = value.toInt32(&err);
+        if (err) {
+            return false;
+        }
+        memcpy(dst, &intValue, sizeof(int32_t));
+    }
+    return true;
+}
+Value Value::makePackedArrayRef(int arraySize, int arrayType, uint32_t id) {
+    auto elementSize = PackedArrayRef::getElementSize(arrayType);
+    if (elementSize == 0) {
+        return makeArrayRef(arraySize, arrayType, id);
+    }
+    if (arraySize < 0) {
+        arraySize = 0;
+    }
+    auto packedArrayRef = ObjectAllocator<PackedArrayRef>::allocate(id);
+	if (packedArrayRef == nullptr) {
+		return Value(0, VALUE_TYPE_NULL);
+	}
+    packedArrayRef->arraySize = 0;
+    packedArrayRef->arrayType = arrayType;
+    packedArrayRef->capacity = 0;
+    packedArrayRef->elementSize = elementSize;
+    packedArrayRef->data = nullptr;
+    if (!packedArrayRef->reserve(arraySize > 0 ? arraySize : 1)) {
+        ObjectAllocator<PackedArrayRef>::deallocate(packedArrayRef);
+        return Value(0, VALUE_TYPE_NULL);
+    }
+    memset(packedArrayRef->data, 0, arraySize * elementSize);
+    packedArrayRef->arraySize = arraySize;
+    packedArrayRef->refCounter = 1;
+    Value value;
+    value.type = VALUE_TYPE_PACKED_ARRAY_REF;
+    value.options = VALUE_OPTIONS_REF;
+    value.refValue = packedArrayRef;
+	return value;
+}
 #if defined(EEZ_FOR_LVGL)
 Value Value::makeLVGLEventRef(uint32_t code, void *currentTarget, void *target, int32_t userData, uint32_t key, int32_t gestureDir, int32_t rotaryDiff, uint32_t id) {
-    auto lvglEventRef = ObjectAllocator<LVGLEventRef>::allocate(id);
+    auto lvglEventRef = allocLVGLEventRef(id);
 	if (lvglEventRef == nullptr) {
 		return Value(0, VALUE_TYPE_NULL);
 	}
@@ -2909,6 +3033,7 @@ Value Value::makeLVGLEventRef(uint32_t code, void *currentTarget, void *target,
     lvglEventRef->key = key;
     lvglEventRef->gestureDir = gestureDir;
     lvglEventRef->rotaryDiff = rotaryDiff;
+    lvglEventRef->time = millis();
     lvglEventRef->refCounter = 1;
     Value value;
     value.type = VALUE_TYPE_EVENT;
@@ -2942,20 +3067,63 @@ Value Value::clone() {
     if (isArray()) {
         auto array = getArray();
         auto resultArrayValue = makeArrayRef(array->arraySize, array->arrayType, 0x0ea48dcb);
+        if (!resultArrayValue.isArray()) {
+            return Value::makeError();
+        }
         auto resultArray = resultArrayValue.getArray();
         for (uint32_t elementIndex = 0; elementIndex < array->arraySize; elementIndex++) {
-            auto elementValue = array->values[elementIndex].clone();
+            auto &srcElementValue = array->values[elementIndex];
+            if (srcElementValue.type == VALUE_TYPE_ARRAY_REF) {
+                auto elementArrayRef = (ArrayValueRef *)srcElementValue.refValue;
+                if (elementArrayRef->refCounter == 1 || elementArrayRef->cowShared) {
+                    elementArrayRef->cowShared = true;
+                    resultArray->values[elementIndex] = srcElementValue;
+                    continue;
+                }
+            }
+            if (!srcElementValue.isArray() && !srcElementValue.isPackedArray() && srcElementValue.type != VALUE_TYPE_STRING) {
+                resultArray->values[elementIndex] = srcElementValue;
+                continue;
+            }
+            auto elementValue = srcElementValue.clone();
             if (elementValue.isError()) {
                 return elementValue;
             }
             resultArray->values[elementIndex] = elementValue;
         }
         return resultArrayValue;
-    } else if (isString()) {
+    } else if (isPackedArray()) {
+        auto packedArray = getPackedArray();
+        auto resultArrayValue = makePackedArrayRef(packedArray->arraySize, packedArray->arrayType, 0x0ea48dcb);
+        if (resultArrayValue.isPackedArray()) {
+            memcpy(resultArrayValue.getPackedArray()->data, packedArray->data, packedArray->arraySize * packedArray->elementSize);
+        }
+        return resultArrayValue;
+    } else if (type == VALUE_TYPE_STRING) {
         return makeStringRef(getString(), -1, 0x91846ff3);
     }
     return *this;
 }
+bool detachArrayElement(ArrayValue *array, uint32_t elementIndex) {
+    auto &elementValue = array->values[elementIndex];
+    if (elementValue.type != VALUE_TYPE_ARRAY_REF) {
+        return true;
+    }
+    auto elementArrayRef = (ArrayValueRef *)elementValue.refValue;
+    if (!elementArrayRef->cowShared) {
+        return true;
+    }
+    if (elementArrayRef->refCounter == 1) {
+        elementArrayRef->cowShared = false;
+        return true;
+    }
+    auto copyValue = elementValue.clone();
+    if (!copyValue.isArray()) {
+        return false;
+    }
+    elementValue = copyValue;
+    return true;
+}
 #if defined(EEZ_OPTION_GUI)
 #if !EEZ_OPTION_GUI
 Value getVar(int16_t id) {
@@ -3134,8 +3302,27 @@ void registerComponent(ComponentTypes componentType, ExecuteComponentFunctionTyp
 		g_executeComponentFunctions[componentType - defs_v3::COMPONENT_TYPE_START_ACTION] = executeComponentFunction;
 	}
 }
+#if EEZ_FLOW_DUAL_CORE
+bool mustExecuteOnLvglCore(FlowState *flowState, unsigned componentIndex) {
+	auto component = getComponent(flowState, componentIndex);
+	if (component->type < defs_v3::COMPONENT_TYPE_START_ACTION || component->type >= defs_v3::FIRST_DASHBOARD_ACTION_COMPONENT_TYPE) {
+		return false;
+	}
+	auto executeComponentFunction = g_executeComponentFunctions[component->type - defs_v3::COMPONENT_TYPE_START_ACTION];
+	if (executeComponentFunction == nullptr) {
+		return false;
+	}
+	if (executeComponentFunction == executeCallActionComponent) {
+		return ((CallActionActionComponent *)component)->flowIndex >= (int)flowState->flowDefinition->flows.count;
+	}
+	return executeComponentFunction == executeLVGLComponent ||
+		executeComponentFunction == executeLVGLApiComponent ||
+		executeComponentFunction == executeShowPageComponent ||
+		executeComponentFunction == executeSetColorThemeComponent;
+}
+#endif
 void executeComponent(FlowState *flowState, unsigned componentIndex) {
-	auto component = flowState->flow->components[componentIndex];
+	auto component = getComponent(flowState, componentIndex);
 	if (component->type >= defs_v3::FIRST_DASHBOARD_ACTION_COMPONENT_TYPE) {
 #if defined(EEZ_DASHBOARD_API)
         executeDashboardComponent(component->type, getFlowStateIndex(flowState), componentIndex);
@@ -3144,6 +3331,12 @@ void executeComponent(FlowState *flowState, unsigned componentIndex) {
     } else if (component->type >= defs_v3::COMPONENT_TYPE_START_ACTION) {
 		auto executeComponentFunction = g_executeComponentFunctions[component->type - defs_v3::COMPONENT_TYPE_START_ACTION];
 		if (executeComponentFunction != nullptr) {
+#if EEZ_FLOW_DUAL_CORE
+			if (!g_isExecutingOnLvglCore && mustExecuteOnLvglCore(flowState, componentIndex)) {
+				postToLvglCore(flowState, componentIndex);
+				return;
+			}
+#endif
 			executeComponentFunction(flowState, componentIndex);
 			return;
 		}
@@ -3280,6 +3473,7 @@ void executeCallAction(FlowState *flowState, unsigned componentIndex, int flowIn
             }
             auto propValuePtr = actionFlowState->values + actionFlowState->flow->componentInputs.count + i;
             *propValuePtr = value;
+            onVariableAssigned(propValuePtr);
             onValueChanged(propValuePtr);
         }
     }
@@ -3291,7 +3485,7 @@ void executeCallAction(FlowState *flowState, unsigned componentIndex, int flowIn
 	}
 }
 void executeCallActionComponent(FlowState *flowState, unsigned componentIndex) {
-	auto component = (CallActionActionComponent *)flowState->flow->components[componentIndex];
+	auto component = (CallActionActionComponent *)getComponent(flowState, componentIndex);
 	auto flowIndex = component->flowIndex;
 	if (flowIndex < 0) {
 		throwError(flowState, componentIndex, FlowError::Plain("Invalid action flow index in CallAction"));
@@ -3323,7 +3517,7 @@ struct CompareActionComponent : public Component {
 	uint8_t conditionInstructions[1];
 };
 void executeCompareComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (CompareActionComponent *)flowState->flow->components[componentIndex];
+    auto component = (CompareActionComponent *)getComponent(flowState, componentIndex);
     Value conditionValue;
     if (!evalExpression(flowState, componentIndex, component->conditionInstructions, conditionValue, FlowError::Property("Compare", "Condition"))) {
         return;
@@ -3353,7 +3547,7 @@ struct ConstantActionComponent : public Component {
 	uint16_t valueIndex;
 };
 void executeConstantComponent(FlowState *flowState, unsigned componentIndex) {
-	auto component = (ConstantActionComponent *)flowState->flow->components[componentIndex];
+	auto component = (ConstantActionComponent *)getComponent(flowState, componentIndex);
 	auto &sourceValue = *flowState->flowDefinition->constants[component->valueIndex];
 	propagateValue(flowState, componentIndex, 1, sourceValue);
 	propagateValueThroughSeqout(flowState, componentIndex);
@@ -3480,7 +3674,7 @@ void executeEvalExprComponent(FlowState *flowState, unsigned componentIndex) {
 namespace eez {
 namespace flow {
 bool getCallActionValue(FlowState *flowState, unsigned componentIndex, Value &value) {
-	auto component = flowState->flow->components[componentIndex];
+	auto component = getComponent(flowState, componentIndex);
 	if (!flowState->parentFlowState) {
 		throwError(flowState, componentIndex, FlowError::Plain("No parentFlowState in Input"));
 		return false;
@@ -3505,8 +3699,7 @@ bool getCallActionValue(FlowState *flowState, unsigned componentIndex, Value &va
         throwError(flowState, componentIndex, FlowError::Plain("Invalid input index in Input"));
         return false;
     }
-    auto &parentComponentInputs = callActionComponent->inputs;
-    auto parentFlowInputIndex = parentComponentInputs[callActionComponentInputIndex];
+    auto parentFlowInputIndex = getComponentInputIndex(flowState->parentFlowState, flowState->parentComponentIndex, callActionComponentInputIndex);
     auto parentFlow = flowState->flowDefinition->flows[flowState->parentFlowState->flowIndex];
     if (parentFlowInputIndex >= parentFlow->componentInputs.count) {
         throwError(flowState, componentIndex, FlowError::Plain("Invalid input index of parent component in Input"));
@@ -3574,7 +3767,7 @@ struct LabelOutActionComponent : public Component {
     int16_t labelInComponentIndex;
 };
 void executeLabelOutComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (LabelOutActionComponent *)flowState->flow->components[componentIndex];
+    auto component = (LabelOutActionComponent *)getComponent(flowState, componentIndex);
     if (component->labelInComponentIndex != -1) {
         propagateValueThroughSeqout(flowState, component->labelInComponentIndex);
     }
@@ -3637,7 +3830,7 @@ void LineChartWidgetComponenentExecutionState::setY(int pointIndex, int lineInde
     *(yValues + pointIndex * numLines + lineIndex) = value;
 }
 bool LineChartWidgetComponenentExecutionState::onInputValue(FlowState *flowState, unsigned componentIndex) {
-    auto component = (LineChartWidgetComponenent *)flowState->flow->components[componentIndex];
+    auto component = (LineChartWidgetComponenent *)getComponent(flowState, componentIndex);
     uint32_t pointIndex;
     if (numPoints < component->maxPoints) {
         pointIndex = numPoints++;
@@ -3672,7 +3865,7 @@ bool LineChartWidgetComponenentExecutionState::onInputValue(FlowState *flowState
     return true;
 }
 void executeLineChartWidgetComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (LineChartWidgetComponenent *)flowState->flow->components[componentIndex];
+    auto component = (LineChartWidgetComponenent *)getComponent(flowState, componentIndex);
     auto executionState = (LineChartWidgetComponenentExecutionState *)flowState->componenentExecutionStates[componentIndex];
     if (!executionState) {
         executionState = allocateComponentExecutionState<LineChartWidgetComponenentExecutionState>(flowState, componentIndex);
@@ -3700,6 +3893,10 @@ void executeLineChartWidgetComponent(FlowState *flowState, unsigned componentInd
             executionState->startPointIndex = 0;
             executionState->numPoints = 0;
             for (uint32_t elementIndex = 0; elementIndex < array->arraySize; elementIndex++) {
+                if (!detachArrayElement(array, elementIndex)) {
+                    throwError(flowState, componentIndex, FlowError::Plain("LineChart Widget: out of memory\n"));
+                    break;
+                }
                 flowState->values[valueInputIndexInFlow] = array->values[elementIndex];
                 if (executionState->onInputValue(flowState, componentIndex)) {
                     updated = true;
@@ -3750,11 +3947,14 @@ struct LoopComponenentExecutionState : public ComponenentExecutionState {
     Value toValue;
     Value currentValue;
 };
+static uint32_t g_loopIterationCounter;
+uint32_t getLoopIterationCounter() {
+    return g_loopIterationCounter;
+}
 void executeLoopComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = flowState->flow->components[componentIndex];
     auto loopComponentExecutionState = (LoopComponenentExecutionState *)flowState->componenentExecutionStates[componentIndex];
     static const unsigned START_INPUT_INDEX = 0;
-    auto startInputIndex = component->inputs[START_INPUT_INDEX];
+    auto startInputIndex = getComponentInputIndex(flowState, componentIndex, START_INPUT_INDEX);
     if (flowState->values[startInputIndex].type != VALUE_TYPE_UNDEFINED) {
         if (loopComponentExecutionState) {
             deallocateComponentExecutionState(flowState, componentIndex);
@@ -3812,6 +4012,7 @@ void executeLoopComponent(FlowState *flowState, unsigned componentIndex) {
         if (loopComponentExecutionState->dstValue.getType() == VALUE_TYPE_FLOW_OUTPUT) {
             assignValue(flowState, componentIndex, loopComponentExecutionState->dstValue, currentValue);
         }
+        g_loopIterationCounter++;
         propagateValueThroughSeqout(flowState, componentIndex);
     }
 }
@@ -3897,8 +4098,336 @@ enum GroupActions {
 struct LVGLExecutionState : public ComponenentExecutionState {
     uint32_t actionIndex;
 };
+struct LVGLWaitListNode {
+    FlowState *flowState;
+    unsigned componentIndex;
+    int32_t objectIndex;
+    LVGLWaitListNode *next;
+};
+static LVGLWaitListNode *g_lvglWaitList;
+static void waitForLvglObject(FlowState *flowState, unsigned componentIndex, int32_t objectIndex) {
+    auto node = (LVGLWaitListNode *)alloc(sizeof(LVGLWaitListNode), 0x3e8a51c7);
+    if (!node) {
+        addToQueue(flowState, componentIndex, -1, -1, -1, true);
+        return;
+    }
+    node->flowState = flowState;
+    node->componentIndex = componentIndex;
+    node->objectIndex = objectIndex;
+    node->next = g_lvglWaitList;
+    g_lvglWaitList = node;
+}
+static void wakeLvglWaits(FlowState *flowState) {
+    LVGLWaitListNode *woken = nullptr;
+    for (auto pNode = &g_lvglWaitList; *pNode; ) {
+        auto node = *pNode;
+        if (flowState ? node->flowState == flowState : getLvglObjectFromIndexHook(node->objectIndex) != nullptr) {
+            *pNode = node->next;
+            node->next = woken;
+            woken = node;
+        } else {
+            pNode = &node->next;
+        }
+    }
+    while (woken) {
+        auto node = woken;
+        woken = node->next;
+        addToQueue(node->flowState, node->componentIndex, -1, -1, -1, true);
+        free(node);
+    }
+}
+void onLvglObjectsCreated() {
+    wakeLvglWaits(nullptr);
+}
+void onLvglFlowStateError(FlowState *flowState) {
+    wakeLvglWaits(flowState);
+}
+void removeLvglWaitsForFlowState(FlowState *flowState) {
+    for (auto pNode = &g_lvglWaitList; *pNode; ) {
+        auto node = *pNode;
+        if (node->flowState == flowState) {
+            *pNode = node->next;
+            free(node);
+        } else {
+            pNode = &node->next;
+        }
+    }
+}
+void lvglWaitListReset() {
+    while (g_lvglWaitList) {
+        auto node = g_lvglWaitList;
+        g_lvglWaitList = node->next;
+        free(node);
+    }
+}
+#ifndef EEZ_FLOW_LVGL_MAX_PENDING_LAYOUT_SCREENS
+#define EEZ_FLOW_LVGL_MAX_PENDING_LAYOUT_SCREENS 4
+#endif
+static lv_obj_t *g_pendingLayoutScreens[EEZ_FLOW_LVGL_MAX_PENDING_LAYOUT_SCREENS];
+static uint32_t g_numPendingLayoutScreens;
+static void requestLvglLayout(lv_obj_t *obj) {
+    lv_obj_t *screen = lv_obj_get_screen(obj);
+    for (uint32_t i = 0; i < g_numPendingLayoutScreens; i++) {
+        if (g_pendingLayoutScreens[i] == screen) {
+            return;
+        }
+    }
+    if (g_numPendingLayoutScreens == EEZ_FLOW_LVGL_MAX_PENDING_LAYOUT_SCREENS) {
+        lv_obj_update_layout(obj);
+        return;
+    }
+    g_pendingLayoutScreens[g_numPendingLayoutScreens++] = screen;
+}
+void flushLvglLayout() {
+    flushLvglWrites();
+    for (uint32_t i = 0; i < g_numPendingLayoutScreens; i++) {
+        lv_obj_update_layout(g_pendingLayoutScreens[i]);
+    }
+    g_numPendingLayoutScreens = 0;
+}
+static bool hasLocalStyleValue(lv_obj_t *obj, lv_style_prop_t prop, int32_t value) {
+    lv_style_value_t styleValue;
+#if LVGL_VERSION_MAJOR >= 9
+    if (lv_obj_get_local_style_prop(obj, prop, &styleValue, 0) != LV_STYLE_RES_FOUND) {
+#else
+    if (lv_obj_get_local_style_prop(obj, prop, &styleValue, 0) != LV_RES_OK) {
+#endif
+        return false;
+    }
+    return styleValue.num == value;
+}
+static bool updateLabelText(lv_obj_t *obj, const char *text) {
+    const char *currentText = lv_label_get_text(obj);
+    if (currentText && strcmp(currentText, text) == 0) {
+        return false;
+    }
+    lv_label_set_text(obj, text);
+    return true;
+}
+static bool updateImageSrc(lv_obj_t *obj, const void *src) {
+    if (lv_img_get_src(obj) == src) {
+        return false;
+    }
+    lv_img_set_src(obj, src);
+    return true;
+}
+static bool updateObjFlag(lv_obj_t *obj, lv_obj_flag_t flag, bool value) {
+    if (lv_obj_has_flag(obj, flag) == value) {
+        return false;
+    }
+    if (value) lv_obj_add_flag(obj, flag);
+    else lv_obj_clear_flag(obj, flag);
+    return true;
+}
+static bool updateObjState(lv_obj_t *obj, lv_state_t state, bool value) {
+    if (lv_obj_has_state(obj, state) == value) {
+        return false;
+    }
+    if (value) lv_obj_add_state(obj, state);
+    else lv_obj_clear_state(obj, state);
+    return true;
+}
+static bool updateObjX(lv_obj_t *obj, int32_t x) {
+    if (hasLocalStyleValue(obj, LV_STYLE_X, x)) {
+        return false;
+    }
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_set_x(obj, x);
+#else
+    lv_obj_set_x(obj, (lv_coord_t)x);
+#endif
+    return true;
+}
+static bool updateObjY(lv_obj_t *obj, int32_t y) {
+    if (hasLocalStyleValue(obj, LV_STYLE_Y, y)) {
+        return false;
+    }
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_set_y(obj, y);
+#else
+    lv_obj_set_y(obj, (lv_coord_t)y);
+#endif
+    return true;
+}
+static bool updateObjWidth(lv_obj_t *obj, int32_t width) {
+    if (hasLocalStyleValue(obj, LV_STYLE_WIDTH, width)) {
+        return false;
+    }
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_set_width(obj, width);
+#else
+    lv_obj_set_width(obj, (lv_coord_t)width);
+#endif
+    return true;
+}
+static bool updateObjHeight(lv_obj_t *obj, int32_t height) {
+    if (hasLocalStyleValue(obj, LV_STYLE_HEIGHT, height)) {
+        return false;
+    }
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_set_height(obj, height);
+#else
+    lv_obj_set_height(obj, (lv_coord_t)height);
+#endif
+    return true;
+}
+static bool updateObjStyleOpa(lv_obj_t *obj, lv_opa_t opa) {
+    if (hasLocalStyleValue(obj, LV_STYLE_OPA, opa)) {
+        return false;
+    }
+    lv_obj_set_style_opa(obj, opa, 0);
+    return true;
+}
+static bool updateRollerSelected(lv_obj_t *obj, uint32_t selected, bool animated) {
+    if (lv_roller_get_selected(obj) == selected) {
+        return false;
+    }
+#if LVGL_VERSION_MAJOR >= 9
+    lv_roller_set_selected(obj, selected, animated ? LV_ANIM_ON : LV_ANIM_OFF);
+#else
+    lv_roller_set_selected(obj, (uint16_t)selected, animated ? LV_ANIM_ON : LV_ANIM_OFF);
+#endif
+    return true;
+}
+enum LvglWriteKind {
+    LVGL_WRITE_PROPERTY,
+    LVGL_WRITE_STYLE,
+    LVGL_WRITE_FLAG,
+    LVGL_WRITE_STATE
+};
+struct LvglPendingWrite {
+    lv_obj_t *obj;
+    LvglWriteKind kind;
+    uint32_t key;
+    int32_t intValue;
+    bool animated;
+    Value value;
+};
+#if EEZ_FLOW_LVGL_MAX_PENDING_WRITES > 0
+static LvglPendingWrite g_pendingLvglWrites[EEZ_FLOW_LVGL_MAX_PENDING_WRITES];
+static uint32_t g_numPendingLvglWrites;
+// open addressing index into g_pendingLvglWrites, 0 is a free slot, otherwise write index + 1
+static uint16_t g_pendingLvglWriteSlots[2 * EEZ_FLOW_LVGL_MAX_PENDING_WRITES];
+static uint32_t getLvglWriteSlot(lv_obj_t *obj, LvglWriteKind kind, uint32_t key) {
+    uint32_t hash = ((uint32_t)(uintptr_t)obj ^ ((uint32_t)kind << 28) ^ (key * 0x9e3779b1)) * 0x85ebca6b;
+    uint32_t slot = (hash >> 16) % (2 * EEZ_FLOW_LVGL_MAX_PENDING_WRITES);
+    while (g_pendingLvglWriteSlots[slot]) {
+        auto &write = g_pendingLvglWrites[g_pendingLvglWriteSlots[slot] - 1];
+        if (write.obj == obj && write.kind == kind && write.key == key) {
+            break;
+        }
+        slot = (slot + 1) % (2 * EEZ_FLOW_LVGL_MAX_PENDING_WRITES);
+    }
+    return slot;
+}
+#endif
+static bool applyLvglProperty(const LvglPendingWrite &write) {
+    auto target = write.obj;
+    auto intValue = write.intValue;
+    switch (write.key) {
+    case IMAGE_IMAGE:
+        return updateImageSrc(target, write.value.getVoidPointer());
+    case LABEL_TEXT:
+        return updateLabelText(target, write.value.getString());
+    case ARC_VALUE:
+        lv_arc_set_value(target, intValue);
+        return true;
+    case BAR_VALUE:
+        lv_bar_set_value(target, intValue, write.animated ? LV_ANIM_ON : LV_ANIM_OFF);
+        return true;
+    case BASIC_X:
+        return updateObjX(target, intValue);
+    case BASIC_Y:
+        return updateObjY(target, intValue);
+    case BASIC_WIDTH:
+        return updateObjWidth(target, intValue);
+    case BASIC_HEIGHT:
+        return updateObjHeight(target, intValue);
+    case BASIC_OPACITY:
+        return updateObjStyleOpa(target, intValue);
+    case DROPDOWN_SELECTED:
+        lv_dropdown_set_selected(target, intValue);
+        return true;
+    case IMAGE_ANGLE:
+        lv_img_set_angle(target, intValue);
+        return true;
+    case IMAGE_ZOOM:
+        lv_img_set_zoom(target, intValue);
+        return true;
+    case ROLLER_SELECTED:
+        return updateRollerSelected(target, intValue, write.animated);
+    case SLIDER_VALUE:
+        lv_slider_set_value(target, intValue, write.animated ? LV_ANIM_ON : LV_ANIM_OFF);
+        return true;
+    }
+    return false;
+}
+static void applyLvglWrite(const LvglPendingWrite &write) {
+    bool changed;
+    if (write.kind == LVGL_WRITE_STYLE) {
+        if (write.intValue) {
+            lvglObjAddStyleHook(write.obj, (int32_t)write.key);
+        } else {
+            lvglObjRemoveStyleHook(write.obj, (int32_t)write.key);
+        }
+        changed = true;
+    } else if (write.kind == LVGL_WRITE_FLAG) {
+        changed = updateObjFlag(write.obj, (lv_obj_flag_t)write.key, write.intValue != 0);
+    } else if (write.kind == LVGL_WRITE_STATE) {
+        changed = updateObjState(write.obj, (lv_state_t)write.key, write.intValue != 0);
+    } else {
+        changed = applyLvglProperty(write);
+    }
+    if (changed) {
+        requestLvglLayout(write.obj);
+    }
+}
+// Writes to the same (object, kind, key) within a tick collapse into the last one. They are
+// applied in flushLvglWrites(), at the end of the tick and before anything that reads LVGL state.
+static void writeLvgl(lv_obj_t *obj, LvglWriteKind kind, uint32_t key, int32_t intValue, bool animated = false, const Value &value = Value()) {
+    LvglPendingWrite immediateWrite;
+    LvglPendingWrite *write = &immediateWrite;
+#if EEZ_FLOW_LVGL_MAX_PENDING_WRITES > 0
+    auto slot = getLvglWriteSlot(obj, kind, key);
+    if (g_pendingLvglWriteSlots[slot]) {
+        write = &g_pendingLvglWrites[g_pendingLvglWriteSlots[slot] - 1];
+    } else if (g_numPendingLvglWrites < EEZ_FLOW_LVGL_MAX_PENDING_WRITES) {
+        write = &g_pendingLvglWrites[g_numPendingLvglWrites++];
+        g_pendingLvglWriteSlots[slot] = (uint16_t)g_numPendingLvglWrites;
+    }
+#endif
+    write->obj = obj;
+    write->kind = kind;
+    write->key = key;
+    write->intValue = intValue;
+    write->animated = animated;
+    write->value = value;
+    if (write == &immediateWrite) {
+        applyLvglWrite(immediateWrite);
+    }
+}
+void flushLvglWrites() {
+#if EEZ_FLOW_LVGL_MAX_PENDING_WRITES > 0
+    if (g_numPendingLvglWrites == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < g_numPendingLvglWrites; i++) {
+        applyLvglWrite(g_pendingLvglWrites[i]);
+    }
+    lvglPendingWritesReset();
+#endif
+}
+void lvglPendingWritesReset() {
+#if EEZ_FLOW_LVGL_MAX_PENDING_WRITES > 0
+    for (uint32_t i = 0; i < g_numPendingLvglWrites; i++) {
+        g_pendingLvglWrites[i].value = Value();
+    }
+    g_numPendingLvglWrites = 0;
+    memset(g_pendingLvglWriteSlots, 0, sizeof(g_pendingLvglWriteSlots));
+#endif
+}
 void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (LVGLComponent *)flowState->flow->components[componentIndex];
+    auto component = (LVGLComponent *)getComponent(flowState, componentIndex);
     auto executionState = (LVGLExecutionState *)flowState->componenentExecutionStates[componentIndex];
     for (uint32_t actionIndex = executionState ? executionState->actionIndex : 0; actionIndex < component->actions.count; actionIndex++) {
         auto general = (LVGLComponent_ActionType *)component->actions[actionIndex];
@@ -3917,7 +4446,7 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             }
             lv_anim_t anim;
@@ -3933,6 +4462,7 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
             if (specific->flags & ANIMATION_ITEM_FLAG_RELATIVE) {
                 lv_anim_set_get_value_cb(&anim, anim_get_callbacks[specific->property]);
             }
+            flushLvglLayout();
             lv_anim_start(&anim);
         } else if (general->action == SET_PROPERTY) {
             auto specific = (LVGLComponent_SetProperty_ActionType *)general;
@@ -3942,7 +4472,7 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             }
             if (specific->property == KEYBOARD_TEXTAREA) {
@@ -3952,26 +4482,27 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                         executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                     }
                     executionState->actionIndex = actionIndex;
-                    addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                    waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->textarea);
                     return;
                 }
                 lv_keyboard_set_textarea(target, textarea);
+                requestLvglLayout(target);
             } else {
                 Value value;
                 if (!evalExpression(flowState, componentIndex, specific->value, value, FlowError::PropertyInAction("LVGL Set Property", "Value", actionIndex))) {
                     return;
                 }
                 if (specific->property == IMAGE_IMAGE || specific->property == LABEL_TEXT) {
-                    const char *strValue = value.toString(0xe42b3ca2).getString();
+                    auto strValue = value.toString(0xe42b3ca2);
                     if (specific->property == IMAGE_IMAGE) {
-                        const void *src = getLvglImageByNameHook(strValue);
+                        const void *src = getLvglImageByNameHook(strValue.getString());
                         if (src) {
-                            lv_img_set_src(target, src);
+                            writeLvgl(target, LVGL_WRITE_PROPERTY, IMAGE_IMAGE, 0, false, Value((void *)src, VALUE_TYPE_POINTER));
                         } else {
-                            throwError(flowState, componentIndex, FlowError::NotFoundInAction("Image", strValue, "LVGL Set Property", actionIndex));
+                            throwError(flowState, componentIndex, FlowError::NotFoundInAction("Image", strValue.getString(), "LVGL Set Property", actionIndex));
                         }
                     } else {
-                        lv_label_set_text(target, strValue ? strValue : "");
+                        writeLvgl(target, LVGL_WRITE_PROPERTY, LABEL_TEXT, 0, false, strValue.getString() ? strValue : Value("", VALUE_TYPE_STRING));
                     }
                 } else if (specific->property == BASIC_HIDDEN) {
                     int err;
@@ -3980,9 +4511,7 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                         throwError(flowState, componentIndex, FlowError::PropertyInActionConvert("LVGL Set Property", "Value", "boolean", actionIndex));
                         return;
                     }
-                    lv_obj_flag_t flag = LV_OBJ_FLAG_HIDDEN;
-                    if (booleanValue) lv_obj_add_flag(target, flag);
-                    else lv_obj_clear_flag(target, flag);
+                    writeLvgl(target, LVGL_WRITE_FLAG, LV_OBJ_FLAG_HIDDEN, booleanValue);
                 } else if (specific->property == BASIC_CHECKED || specific->property == BASIC_DISABLED) {
                     int err;
                     bool booleanValue = value.toBool(&err);
@@ -3990,9 +4519,7 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                         throwError(flowState, componentIndex, FlowError::PropertyInActionConvert("LVGL Set Property", "Value", "boolean", actionIndex));
                         return;
                     }
-                    lv_state_t state = specific->property == BASIC_CHECKED ? LV_STATE_CHECKED : LV_STATE_DISABLED;
-                    if (booleanValue) lv_obj_add_state(target, state);
-                    else lv_obj_clear_state(target, state);
+                    writeLvgl(target, LVGL_WRITE_STATE, specific->property == BASIC_CHECKED ? LV_STATE_CHECKED : LV_STATE_DISABLED, booleanValue);
                 } else {
                     int err;
                     int32_t intValue = value.toInt32(&err);
@@ -4000,34 +4527,9 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                         throwError(flowState, componentIndex, FlowError::PropertyInActionConvert("LVGL Set Property", "Value", "integer", actionIndex));
                         return;
                     }
-                    if (specific->property == ARC_VALUE) {
-                        lv_arc_set_value(target, intValue);
-                    } else if (specific->property == BAR_VALUE) {
-                        lv_bar_set_value(target, intValue, specific->animated ? LV_ANIM_ON : LV_ANIM_OFF);
-                    } else if (specific->property == BASIC_X) {
-                        lv_obj_set_x(target, intValue);
-                    } else if (specific->property == BASIC_Y) {
-                        lv_obj_set_y(target, intValue);
-                    } else if (specific->property == BASIC_WIDTH) {
-                        lv_obj_set_width(target, intValue);
-                    } else if (specific->property == BASIC_HEIGHT) {
-                        lv_obj_set_height(target, intValue);
-                    } else if (specific->property == BASIC_OPACITY) {
-                        lv_obj_set_style_opa(target, intValue, 0);
-                    } else if (specific->property == DROPDOWN_SELECTED) {
-                        lv_dropdown_set_selected(target, intValue);
-                    } else if (specific->property == IMAGE_ANGLE) {
-                        lv_img_set_angle(target, intValue);
-                    } else if (specific->property == IMAGE_ZOOM) {
-                        lv_img_set_zoom(target, intValue);
-                    } else if (specific->property == ROLLER_SELECTED) {
-                        lv_roller_set_selected(target, intValue, specific->animated ? LV_ANIM_ON : LV_ANIM_OFF);
-                    } else if (specific->property == SLIDER_VALUE) {
-                        lv_slider_set_value(target, intValue, specific->animated ? LV_ANIM_ON : LV_ANIM_OFF);
-                    }
+                    writeLvgl(target, LVGL_WRITE_PROPERTY, specific->property, intValue, specific->animated ? true : false);
                 }
             }
-            lv_obj_update_layout(target);
         } else if (general->action == ADD_STYLE) {
             auto specific = (LVGLComponent_AddStyle_ActionType *)general;
             auto target = getLvglObjectFromIndexHook(flowState->lvglWidgetStartIndex + specific->target);
@@ -4036,10 +4538,10 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             } else {
-                lvglObjAddStyleHook(target, specific->style);
+                writeLvgl(target, LVGL_WRITE_STYLE, (uint32_t)specific->style, 1);
             }
         } else if (general->action == REMOVE_STYLE) {
             auto specific = (LVGLComponent_RemoveStyle_ActionType *)general;
@@ -4049,10 +4551,10 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             } else {
-                lvglObjRemoveStyleHook(target, specific->style);
+                writeLvgl(target, LVGL_WRITE_STYLE, (uint32_t)specific->style, 0);
             }
         } else if (general->action == ADD_FLAG) {
             auto specific = (LVGLComponent_AddFlag_ActionType *)general;
@@ -4062,10 +4564,10 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             } else {
-                lv_obj_add_flag(target, (lv_obj_flag_t)specific->flag);
+                writeLvgl(target, LVGL_WRITE_FLAG, specific->flag, 1);
             }
         } else if (general->action == CLEAR_FLAG) {
             auto specific = (LVGLComponent_ClearFlag_ActionType *)general;
@@ -4075,10 +4577,10 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             } else {
-                lv_obj_clear_flag(target, (lv_obj_flag_t)specific->flag);
+                writeLvgl(target, LVGL_WRITE_FLAG, specific->flag, 0);
             }
         } else if (general->action == GROUP) {
             auto specific = (LVGLComponent_Group_ActionType *)general;
@@ -4094,7 +4596,7 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                         executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                     }
                     executionState->actionIndex = actionIndex;
-                    addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                    waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                     return;
                 } else {
                     lv_group_focus_obj(target);
@@ -4128,10 +4630,10 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             } else {
-                lv_obj_add_state(target, (lv_state_t)specific->state);
+                writeLvgl(target, LVGL_WRITE_STATE, specific->state, 1);
             }
         } else if (general->action == CLEAR_STATE) {
             auto specific = (LVGLComponent_ClearState_ActionType *)general;
@@ -4141,10 +4643,10 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     executionState = allocateComponentExecutionState<LVGLExecutionState>(flowState, componentIndex);
                 }
                 executionState->actionIndex = actionIndex;
-                addToQueue(flowState, componentIndex, -1, -1, -1, true);
+                waitForLvglObject(flowState, componentIndex, flowState->lvglWidgetStartIndex + specific->target);
                 return;
             } else {
-                lv_obj_clear_state(target, (lv_state_t)specific->state);
+                writeLvgl(target, LVGL_WRITE_STATE, specific->state, 0);
             }
         }
     }
@@ -4325,14 +4827,11 @@ ACTION_END
 ACTION_START(objSetX)
     WIDGET_PROP(obj);
     INT32_PROP(x);
-#if LVGL_VERSION_MAJOR >= 9
-    lv_obj_set_x(obj, x);
-#else
-    lv_obj_set_x(obj, (lv_coord_t)x);
-#endif
+    updateObjX(obj, x);
 ACTION_END
 ACTION_START(objGetX)
     WIDGET_PROP(obj);
+    flushLvglLayout();
 #if LVGL_VERSION_MAJOR >= 9
     int32_t x = (int32_t)lv_obj_get_x(obj);
 #else
@@ -4343,14 +4842,11 @@ ACTION_END
 ACTION_START(objSetY)
     WIDGET_PROP(obj);
     INT32_PROP(y);
-#if LVGL_VERSION_MAJOR >= 9
-    lv_obj_set_y(obj, y);
-#else
-    lv_obj_set_y(obj, (lv_coord_t)y);
-#endif
+    updateObjY(obj, y);
 ACTION_END
 ACTION_START(objGetY)
     WIDGET_PROP(obj);
+    flushLvglLayout();
 #if LVGL_VERSION_MAJOR >= 9
     int32_t y = (int32_t)lv_obj_get_y(obj);
 #else
@@ -4361,14 +4857,11 @@ ACTION_END
 ACTION_START(objSetWidth)
     WIDGET_PROP(obj);
     INT32_PROP(width);
-#if LVGL_VERSION_MAJOR >= 9
-    lv_obj_set_width(obj, width);
-#else
-    lv_obj_set_width(obj, (lv_coord_t)width);
-#endif
+    updateObjWidth(obj, width);
 ACTION_END
 ACTION_START(objGetWidth)
     WIDGET_PROP(obj);
+    flushLvglLayout();
 #if LVGL_VERSION_MAJOR >= 9
     int32_t width = (int32_t)lv_obj_get_width(obj);
 #else
@@ -4379,14 +4872,11 @@ ACTION_END
 ACTION_START(objSetHeight)
     WIDGET_PROP(obj);
     INT32_PROP(height);
-#if LVGL_VERSION_MAJOR >= 9
-    lv_obj_set_height(obj, height);
-#else
-    lv_obj_set_height(obj, (lv_coord_t)height);
-#endif
+    updateObjHeight(obj, height);
 ACTION_END
 ACTION_START(objGetHeight)
     WIDGET_PROP(obj);
+    flushLvglLayout();
 #if LVGL_VERSION_MAJOR >= 9
     int32_t height = (int32_t)lv_obj_get_height(obj);
 #else
@@ -4397,7 +4887,7 @@ ACTION_END
 ACTION_START(objSetStyleOpa)
     WIDGET_PROP(obj);
     INT32_PROP(opa);
-    lv_obj_set_style_opa(obj, (lv_opa_t)opa, 0);
+    updateObjStyleOpa(obj, (lv_opa_t)opa);
 ACTION_END
 ACTION_START(objGetStyleOpa)
     WIDGET_PROP(obj);
@@ -4417,8 +4907,7 @@ ACTION_END
 ACTION_START(objSetFlagHidden)
     WIDGET_PROP(obj);
     BOOL_PROP(hidden);
-    if (hidden) lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
-    else lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    updateObjFlag(obj, LV_OBJ_FLAG_HIDDEN, hidden);
 ACTION_END
 ACTION_START(objAddFlag)
     WIDGET_PROP(obj);
@@ -4439,14 +4928,12 @@ ACTION_END
 ACTION_START(objSetStateChecked)
     WIDGET_PROP(obj);
     BOOL_PROP(checked);
-    if (checked) lv_obj_add_state(obj, LV_STATE_CHECKED);
-    else lv_obj_clear_state(obj, LV_STATE_CHECKED);
+    updateObjState(obj, LV_STATE_CHECKED, checked);
 ACTION_END
 ACTION_START(objSetStateDisabled)
     WIDGET_PROP(obj);
     BOOL_PROP(disabled);
-    if (disabled) lv_obj_add_state(obj, LV_STATE_DISABLED);
-    else lv_obj_clear_state(obj, LV_STATE_DISABLED);
+    updateObjState(obj, LV_STATE_DISABLED, disabled);
 ACTION_END
 ACTION_START(objAddState)
     WIDGET_PROP(obj);
@@ -4489,7 +4976,7 @@ ACTION_START(imageSetSrc)
     STR_PROP(str);
     const void *src = getLvglImageByNameHook(str);
     if (src) {
-        lv_img_set_src(obj, src);
+        updateImageSrc(obj, src);
     } else {
         throwError(flowState, componentIndex, FlowError::NotFoundInAction("Image", str, "imageSetSrc", actionIndex));
     }
@@ -4507,7 +4994,7 @@ ACTION_END
 ACTION_START(labelSetText)
     WIDGET_PROP(obj);
     STR_PROP(text);
-    lv_label_set_text(obj, text);
+    updateLabelText(obj, text);
 ACTION_END
 ACTION_START(qrCodeUpdate)
     WIDGET_PROP(obj);
@@ -4520,11 +5007,7 @@ ACTION_START(rollerSetSelected)
     WIDGET_PROP(obj);
     UINT32_PROP(selected);
     BOOL_PROP(animated);
-#if LVGL_VERSION_MAJOR >= 9
-    lv_roller_set_selected(obj, selected, animated ? LV_ANIM_ON : LV_ANIM_OFF);
-#else
-    lv_roller_set_selected(obj, (uint16_t)selected, animated ? LV_ANIM_ON : LV_ANIM_OFF);
-#endif
+    updateRollerSelected(obj, selected, animated);
 ACTION_END
 ACTION_START(sliderSetValue)
     WIDGET_PROP(obj);
@@ -4614,6 +5097,7 @@ static void playAnimation(lv_obj_t *obj,
     if (relative) {
         lv_anim_set_get_value_cb(&anim, get_callback);
     }
+    flushLvglLayout();
     lv_anim_start(&anim);
 }
 ACTION_START(animX)
@@ -4775,8 +5259,9 @@ struct LVGLApiExecutionState : public ComponenentExecutionState {
     uint32_t actionIndex;
 };
 void executeLVGLApiComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (LVGLApiComponent *)flowState->flow->components[componentIndex];
+    auto component = (LVGLApiComponent *)getComponent(flowState, componentIndex);
     auto executionState = (LVGLApiExecutionState *)flowState->componenentExecutionStates[componentIndex];
+    flushLvglWrites();
     for (uint32_t actionIndex = executionState ? executionState->actionIndex : 0; actionIndex < component->actions.count; actionIndex++) {
         auto actionType = (LVGLApiComponent_ActionType *)component->actions[actionIndex];
         (*actions[actionType->action])(flowState, componentIndex, actionType->properties, actionIndex);
@@ -4810,7 +5295,7 @@ struct LVGLUserWidgetComponent : public Component {
     int32_t widgetStartIndex;
 };
 LVGLUserWidgetExecutionState *createUserWidgetFlowState(FlowState *flowState, unsigned userWidgetWidgetComponentIndex) {
-    auto component = (LVGLUserWidgetComponent *)flowState->flow->components[userWidgetWidgetComponentIndex];
+    auto component = (LVGLUserWidgetComponent *)getComponent(flowState, userWidgetWidgetComponentIndex);
     auto userWidgetFlowState = initPageFlowState(flowState->assets, component->flowIndex, flowState, userWidgetWidgetComponentIndex);
     userWidgetFlowState->lvglWidgetStartIndex = component->widgetStartIndex;
     auto offset = defs_v3::LVGL_USER_WIDGET_WIDGET_USER_PROPERTIES_START;
@@ -4830,12 +5315,11 @@ void executeLVGLUserWidgetComponent(FlowState *flowState, unsigned componentInde
         userWidgetWidgetExecutionState = createUserWidgetFlowState(flowState, componentIndex);
     }
     auto userWidgetFlowState = userWidgetWidgetExecutionState->flowState;
-    for (
-        unsigned userWidgetComponentIndex = 0;
-        userWidgetComponentIndex < userWidgetFlowState->flow->components.count;
-        userWidgetComponentIndex++
-    ) {
-        auto userWidgetComponent = userWidgetFlowState->flow->components[userWidgetComponentIndex];
+    uint32_t numComponents = userWidgetFlowState->flow->components.count;
+    auto callInputComponents = getCallInputComponents(userWidgetFlowState, numComponents);
+    for (uint32_t i = 0; i < numComponents; i++) {
+        unsigned userWidgetComponentIndex = callInputComponents ? callInputComponents[i] : i;
+        auto userWidgetComponent = getComponent(userWidgetFlowState, userWidgetComponentIndex);
         if (userWidgetComponent->type == defs_v3::COMPONENT_TYPE_INPUT_ACTION) {
             auto inputActionComponentExecutionState = (InputActionComponentExecutionState *)userWidgetFlowState->componenentExecutionStates[userWidgetComponentIndex];
             if (inputActionComponentExecutionState) {
@@ -5336,7 +5820,7 @@ void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventD
         auto componentExecutionState = eventHandler->componentExecutionState;
         auto flowState = componentExecutionState->flowState;
         auto componentIndex = componentExecutionState->componentIndex;
-        auto component = (MQTTEventActionComponenent *)flowState->flow->components[componentIndex];
+        auto component = (MQTTEventActionComponenent *)getComponent(flowState, componentIndex);
         if (event == EEZ_MQTT_EVENT_CONNECT) {
             if (component->connectEventOutputIndex >= 0) {
                 componentExecutionState->addEvent(component->connectEventOutputIndex);
@@ -5461,7 +5945,7 @@ struct OutputActionComponent : public Component {
 	uint8_t outputIndex;
 };
 void executeOutputComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (OutputActionComponent *)flowState->flow->components[componentIndex];
+    auto component = (OutputActionComponent *)getComponent(flowState, componentIndex);
 	if (!flowState->parentFlowState) {
 		throwError(flowState, componentIndex, FlowError::Plain("No parentFlowState in Output"));
 		return;
@@ -5470,7 +5954,7 @@ void executeOutputComponent(FlowState *flowState, unsigned componentIndex) {
 		throwError(flowState, componentIndex, FlowError::Plain("No parentComponent in Output"));
 		return;
 	}
-    auto inputIndex = component->inputs[0];
+    auto inputIndex = getComponentInputIndex(flowState, componentIndex, 0);
     if (inputIndex >= flowState->flow->componentInputs.count) {
         throwError(flowState, componentIndex, FlowError::Plain("Invalid input index in Output"));
 		return;
@@ -5564,16 +6048,51 @@ void executeSetColorThemeComponent(FlowState *flowState, unsigned componentIndex
 #include <stdio.h>
 namespace eez {
 namespace flow {
-void executeSetVariableComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (SetVariableActionComponent *)flowState->flow->components[componentIndex];
-    for (uint32_t entryIndex = 0; entryIndex < component->entries.count; entryIndex++) {
-        auto entry = component->entries[entryIndex];
-        Value dstValue;
-        if (!evalAssignableExpression(flowState, componentIndex, entry->variable, dstValue, FlowError::PropertyInArray("SetVariable", "Variable", entryIndex))) {
-            return;
-        }
+static uint16_t getInstruction(const uint8_t *instructions, int instructionIndex) {
+    return instructions[2 * instructionIndex] + (instructions[2 * instructionIndex + 1] << 8);
+}
+static bool isArrayUpdateExpression(const uint8_t *instructions) {
+    int i;
+    for (i = 0; i < 3; i++) {
+        auto instructionType = getInstruction(instructions, i) & EXPR_EVAL_INSTRUCTION_TYPE_MASK;
+        if (
+            instructionType != EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT &&
+            instructionType != EXPR_EVAL_INSTRUCTION_TYPE_PUSH_INPUT &&
+            instructionType != EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR &&
+            instructionType != EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR
+        ) {
+            break;
+        }
+    }
+    auto instruction = getInstruction(instructions, i);
+    if (i < 2 || (instruction & EXPR_EVAL_INSTRUCTION_TYPE_MASK) != EXPR_EVAL_INSTRUCTION_TYPE_OPERATION) {
+        return false;
+    }
+    auto operation = instruction & EXPR_EVAL_INSTRUCTION_PARAM_MASK;
+    if (
+        operation != defs_v3::OPERATION_TYPE_ARRAY_APPEND &&
+        operation != defs_v3::OPERATION_TYPE_ARRAY_INSERT &&
+        operation != defs_v3::OPERATION_TYPE_ARRAY_REMOVE
+    ) {
+        return false;
+    }
+    return (getInstruction(instructions, i + 1) & EXPR_EVAL_INSTRUCTION_TYPE_MASK) == EXPR_EVAL_INSTRUCTION_TYPE_END;
+}
+void executeSetVariableComponent(FlowState *flowState, unsigned componentIndex) {
+    auto component = (SetVariableActionComponent *)getComponent(flowState, componentIndex);
+    for (uint32_t entryIndex = 0; entryIndex < component->entries.count; entryIndex++) {
+        auto entry = component->entries[entryIndex];
+        Value dstValue;
+        if (!evalAssignableExpression(flowState, componentIndex, entry->variable, dstValue, FlowError::PropertyInArray("SetVariable", "Variable", entryIndex))) {
+            return;
+        }
         Value srcValue;
-        if (!evalExpression(flowState, componentIndex, entry->value, srcValue, FlowError::PropertyInArray("SetVariable", "Value", entryIndex))) {
+        if (dstValue.getType() == VALUE_TYPE_VALUE_PTR && isArrayUpdateExpression(entry->value)) {
+            g_stack.assignmentTarget = dstValue.pValueValue;
+        }
+        bool evaluated = evalExpression(flowState, componentIndex, entry->value, srcValue, FlowError::PropertyInArray("SetVariable", "Value", entryIndex));
+        g_stack.assignmentTarget = nullptr;
+        if (!evaluated) {
             return;
         }
         assignValue(flowState, componentIndex, dstValue, srcValue);
@@ -5591,7 +6110,7 @@ struct ShowPageActionComponent : public Component {
 	int16_t page;
 };
 void executeShowPageComponent(FlowState *flowState, unsigned componentIndex) {
-	auto component = (ShowPageActionComponent *)flowState->flow->components[componentIndex];
+	auto component = (ShowPageActionComponent *)getComponent(flowState, componentIndex);
 	replacePageHook(component->page, 0, 0, 0);
 	propagateValueThroughSeqout(flowState, componentIndex);
 }
@@ -5604,71 +6123,240 @@ void executeShowPageComponent(FlowState *flowState, unsigned componentIndex) {
 #include <stdlib.h>
 namespace eez {
 namespace flow {
-SortArrayActionComponent *g_sortArrayActionComponent;
-static int elementCompare(const void *a, const void *b) {
-    auto aValue = *(const Value *)a;
-    auto bValue = *(const Value *)b;
-    if (g_sortArrayActionComponent->arrayType != -1) {
-        if (!aValue.isArray()) {
-            return 0;
+struct SortArrayKey {
+    const char *string;
+    double number;
+    bool isNumber;
+};
+static inline int compareSortArrayKeys(const SortArrayKey &a, const SortArrayKey &b, uint32_t flags) {
+    int result;
+    if (a.string && b.string) {
+        if (flags & SORT_ARRAY_FLAG_IGNORE_CASE) {
+            result = utf8casecmp(a.string, b.string);
+        } else {
+            result = utf8cmp(a.string, b.string);
+        }
+    } else if (a.isNumber && b.isNumber) {
+        result = a.number < b.number ? -1 : a.number > b.number ? 1 : 0;
+    } else {
+        return 0;
+    }
+    return flags & SORT_ARRAY_FLAG_ASCENDING ? result : -result;
+}
+static const uint32_t SORT_ARRAY_MERGES_PER_TIME_CHECK = 256;
+struct ArraySorter {
+    ArrayValue *array = nullptr;
+    PackedArrayRef *packedArray = nullptr;
+    uint32_t arraySize = 0;
+    uint32_t flags = 0;
+    SortArrayKey *keys = nullptr;
+    uint32_t *src = nullptr;
+    uint32_t *dst = nullptr;
+    uint32_t width = 1;
+    uint32_t position = 0;
+    bool init(SortArrayActionComponent *component, ArrayValue *array_) {
+        array = array_;
+        if (!allocKeys(component, array->arraySize)) {
+            return false;
+        }
+        auto n = arraySize;
+        bool allStrings = true;
+        for (uint32_t i = 0; i < n; i++) {
+            auto pValue = getSortValue(component, i);
+            keys[i].string = pValue && pValue->isString() ? pValue->getString() : nullptr;
+            keys[i].isNumber = false;
+            if (!keys[i].string) {
+                allStrings = false;
+            }
+        }
+        if (!allStrings) {
+            for (uint32_t i = 0; i < n; i++) {
+                auto pValue = getSortValue(component, i);
+                if (pValue) {
+                    int err;
+                    keys[i].number = pValue->toDouble(&err);
+                    keys[i].isNumber = !err;
+                }
+            }
         }
-        auto aArray = aValue.getArray();
-        if ((uint32_t)g_sortArrayActionComponent->structFieldIndex >= aArray->arraySize) {
-            return 0;
+        return true;
+    }
+    bool init(SortArrayActionComponent *component, PackedArrayRef *packedArray_) {
+        packedArray = packedArray_;
+        if (!allocKeys(component, packedArray->arraySize)) {
+            return false;
         }
-        aValue = aArray->values[g_sortArrayActionComponent->structFieldIndex];
-        if (!bValue.isArray()) {
-            return 0;
+        for (uint32_t i = 0; i < arraySize; i++) {
+            keys[i].string = nullptr;
+            keys[i].number = packedArray->get(i).toDouble(nullptr);
+            keys[i].isNumber = true;
         }
-        auto bArray = bValue.getArray();
-        if ((uint32_t)g_sortArrayActionComponent->structFieldIndex >= bArray->arraySize) {
-            return 0;
+        return true;
+    }
+    bool sort(bool canYield) {
+        auto n = arraySize;
+        uint32_t numMerged = 0;
+        while (width < n) {
+            while (position < n) {
+                auto from = position;
+                auto mid = from + width < n ? from + width : n;
+                auto to = mid + width < n ? mid + width : n;
+                mergeRuns(from, mid, to);
+                position = to;
+                numMerged += to - from;
+                if (canYield && numMerged >= SORT_ARRAY_MERGES_PER_TIME_CHECK) {
+                    numMerged = 0;
+                    if (isTickTimeBudgetSpent()) {
+                        return false;
+                    }
+                }
+            }
+            auto temp = src;
+            src = dst;
+            dst = temp;
+            width *= 2;
+            position = 0;
+        }
+        permute();
+        release();
+        return true;
+    }
+    void release() {
+        if (keys) {
+            free(keys);
+            keys = nullptr;
         }
-        bValue = bArray->values[g_sortArrayActionComponent->structFieldIndex];
     }
-    int result;
-    if (aValue.isString() && bValue.isString()) {
-        if (g_sortArrayActionComponent->flags & SORT_ARRAY_FLAG_IGNORE_CASE) {
-            result = utf8casecmp(aValue.getString(), bValue.getString());
-        } else {
-            result = utf8cmp(aValue.getString(), bValue.getString());
+private:
+    bool allocKeys(SortArrayActionComponent *component, uint32_t n) {
+        flags = component->flags;
+        arraySize = n;
+        keys = (SortArrayKey *)alloc(n * (sizeof(SortArrayKey) + 2 * sizeof(uint32_t)) + 1, 0x3b5e1d27);
+        if (!keys) {
+            return false;
         }
-    } else {
-        int err;
-        float aDouble = aValue.toDouble(&err);
-        if (err) {
-            return 0;
+        src = (uint32_t *)(keys + n);
+        dst = src + n;
+        for (uint32_t i = 0; i < n; i++) {
+            src[i] = i;
         }
-        float bDouble = bValue.toDouble(&err);
-        if (err) {
-            return 0;
+        width = 1;
+        position = 0;
+        return true;
+    }
+    const Value *getSortValue(SortArrayActionComponent *component, uint32_t i) {
+        auto pValue = &array->values[i];
+        if (component->arrayType != -1) {
+            if (!pValue->isArray()) {
+                return nullptr;
+            }
+            auto structValue = pValue->getArray();
+            if ((uint32_t)component->structFieldIndex >= structValue->arraySize) {
+                return nullptr;
+            }
+            pValue = &structValue->values[component->structFieldIndex];
+        }
+        return pValue;
+    }
+    void mergeRuns(uint32_t from, uint32_t mid, uint32_t to) {
+        auto i = from;
+        auto j = mid;
+        auto k = from;
+        while (i < mid && j < to) {
+            if (compareSortArrayKeys(keys[src[j]], keys[src[i]], flags) < 0) {
+                dst[k++] = src[j++];
+            } else {
+                dst[k++] = src[i++];
+            }
+        }
+        while (i < mid) {
+            dst[k++] = src[i++];
+        }
+        while (j < to) {
+            dst[k++] = src[j++];
+        }
+    }
+    void permute() {
+        auto elements = packedArray ? packedArray->data : (uint8_t *)array->values;
+        auto elementSize = packedArray ? packedArray->elementSize : sizeof(Value);
+        for (uint32_t k = 0; k < arraySize; k++) {
+            if (src[k] == k) {
+                continue;
+            }
+            alignas(Value) uint8_t temp[sizeof(Value)];
+            memcpy(temp, elements + k * elementSize, elementSize);
+            auto j = k;
+            while (true) {
+                auto from = src[j];
+                src[j] = j;
+                if (from == k) {
+                    memcpy(elements + j * elementSize, temp, elementSize);
+                    break;
+                }
+                memcpy(elements + j * elementSize, elements + from * elementSize, elementSize);
+                j = from;
+            }
         }
-        auto diff = aDouble - bDouble;
-        result = diff < 0 ? -1 : diff > 0 ? 1 : 0;
     }
-    if (!(g_sortArrayActionComponent->flags & SORT_ARRAY_FLAG_ASCENDING)) {
-        result = -result;
+};
+bool sortArray(SortArrayActionComponent *component, ArrayValue *array) {
+    ArraySorter sorter;
+    if (!sorter.init(component, array)) {
+        return false;
     }
-    return result;
+    sorter.sort(false);
+    return true;
 }
-void sortArray(SortArrayActionComponent *component, ArrayValue *array) {
-    g_sortArrayActionComponent = component;
-    qsort(&array->values[0], array->arraySize, sizeof(Value), elementCompare);
+bool sortArray(SortArrayActionComponent *component, PackedArrayRef *packedArray) {
+    ArraySorter sorter;
+    if (!sorter.init(component, packedArray)) {
+        return false;
+    }
+    sorter.sort(false);
+    return true;
 }
+#if !defined(EEZ_FLOW_SORT_ARRAY_INCREMENTAL_MIN_SIZE)
+#define EEZ_FLOW_SORT_ARRAY_INCREMENTAL_MIN_SIZE 256
+#endif
+struct SortArrayComponenentExecutionState : public ComponenentExecutionState {
+    Value arrayValue;
+    ArraySorter sorter;
+    ~SortArrayComponenentExecutionState() {
+        sorter.release();
+    }
+};
 void executeSortArrayComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (SortArrayActionComponent *)flowState->flow->components[componentIndex];
+    auto component = (SortArrayActionComponent *)getComponent(flowState, componentIndex);
+    auto sortArrayExecutionState = (SortArrayComponenentExecutionState *)flowState->componenentExecutionStates[componentIndex];
+    if (sortArrayExecutionState) {
+        if (!sortArrayExecutionState->sorter.sort(true)) {
+            addToQueue(flowState, componentIndex, -1, -1, -1, true);
+            return;
+        }
+        Value arrayValue = sortArrayExecutionState->arrayValue;
+        deallocateComponentExecutionState(flowState, componentIndex);
+        propagateValue(flowState, componentIndex, component->outputs.count - 1, arrayValue);
+        return;
+    }
     Value srcArrayValue;
     if (!evalProperty(flowState, componentIndex, defs_v3::SORT_ARRAY_ACTION_COMPONENT_PROPERTY_ARRAY, srcArrayValue, FlowError::Property("SortArray", "Array"))) {
         return;
     }
-    if (!srcArrayValue.isArray()) {
+    if (!srcArrayValue.isArray() && !srcArrayValue.isPackedArray()) {
         throwError(flowState, componentIndex, FlowError::Plain("SortArray: not an array\n"));
         return;
     }
     auto arrayValue = srcArrayValue.clone();
-    auto array = arrayValue.getArray();
+    if (arrayValue.isError()) {
+        throwError(flowState, componentIndex, FlowError::Plain("SortArray: out of memory\n"));
+        return;
+    }
+    auto packedArray = arrayValue.isPackedArray() ? arrayValue.getPackedArray() : nullptr;
+    auto array = packedArray ? nullptr : arrayValue.getArray();
+    auto arrayType = packedArray ? packedArray->arrayType : array->arrayType;
+    auto arraySize = packedArray ? packedArray->arraySize : array->arraySize;
     if (component->arrayType != -1) {
-        if (array->arrayType != (uint32_t)component->arrayType) {
+        if (arrayType != (uint32_t)component->arrayType) {
             throwError(flowState, componentIndex, FlowError::Plain("SortArray: invalid array type\n"));
             return;
         }
@@ -5676,12 +6364,32 @@ void executeSortArrayComponent(FlowState *flowState, unsigned componentIndex) {
             throwError(flowState, componentIndex, FlowError::Plain("SortArray: invalid struct field index\n"));
         }
     } else {
-        if (array->arrayType != defs_v3::ARRAY_TYPE_INTEGER && array->arrayType != defs_v3::ARRAY_TYPE_FLOAT && array->arrayType != defs_v3::ARRAY_TYPE_DOUBLE && array->arrayType != defs_v3::ARRAY_TYPE_STRING) {
+        if (arrayType != defs_v3::ARRAY_TYPE_INTEGER && arrayType != defs_v3::ARRAY_TYPE_FLOAT && arrayType != defs_v3::ARRAY_TYPE_DOUBLE && arrayType != defs_v3::ARRAY_TYPE_STRING) {
             throwError(flowState, componentIndex, FlowError::Plain("SortArray: array type is neither array:integer or array:float or array:double or array:string\n"));
             return;
         }
     }
-    sortArray(component, array);
+    if (arraySize >= EEZ_FLOW_SORT_ARRAY_INCREMENTAL_MIN_SIZE) {
+        sortArrayExecutionState = allocateComponentExecutionState<SortArrayComponenentExecutionState>(flowState, componentIndex);
+        sortArrayExecutionState->arrayValue = arrayValue;
+        auto &sorter = sortArrayExecutionState->sorter;
+        if (!(packedArray ? sorter.init(component, packedArray) : sorter.init(component, array))) {
+            deallocateComponentExecutionState(flowState, componentIndex);
+            throwError(flowState, componentIndex, FlowError::Plain("SortArray: out of memory\n"));
+            return;
+        }
+        if (!sortArrayExecutionState->sorter.sort(true)) {
+            addToQueue(flowState, componentIndex, -1, -1, -1, true);
+            return;
+        }
+        deallocateComponentExecutionState(flowState, componentIndex);
+        propagateValue(flowState, componentIndex, component->outputs.count - 1, arrayValue);
+        return;
+    }
+    if (!(packedArray ? sortArray(component, packedArray) : sortArray(component, array))) {
+        throwError(flowState, componentIndex, FlowError::Plain("SortArray: out of memory\n"));
+        return;
+    }
 	propagateValue(flowState, componentIndex, component->outputs.count - 1, arrayValue);
 }
 } 
@@ -5703,7 +6411,7 @@ void executeStartComponent(FlowState *flowState, unsigned componentIndex) {
 namespace eez {
 namespace flow {
 void executeSwitchComponent(FlowState *flowState, unsigned componentIndex) {
-    auto component = (SwitchActionComponent *)flowState->flow->components[componentIndex];
+    auto component = (SwitchActionComponent *)getComponent(flowState, componentIndex);
     for (uint32_t testIndex = 0; testIndex < component->tests.count; testIndex++) {
         auto test = component->tests[testIndex];
         Value conditionValue;
@@ -6168,7 +6876,7 @@ bool canExecuteStep(FlowState *&flowState, unsigned &componentIndex) {
 	    setDebuggerState(DEBUGGER_STATE_PAUSED);
         return true;
     }
-    auto component = flowState->flow->components[componentIndex];
+    auto component = getComponent(flowState, componentIndex);
     if (g_skipNextBreakpoint) {
         if (component->breakpoint) {
             g_skipNextBreakpoint = false;
@@ -6340,6 +7048,9 @@ static void writeValue(const Value &value) {
 	case VALUE_TYPE_BLOB_REF:
 		snprintf(tempStr, sizeof(tempStr) - 1, "@%d", (int)((BlobRef *)value.refValue)->len);
 		break;
+	case VALUE_TYPE_PACKED_ARRAY_REF:
+		snprintf(tempStr, sizeof(tempStr) - 1, "@%d", (int)(value.getPackedArray()->arraySize * value.getPackedArray()->elementSize));
+		break;
 	case VALUE_TYPE_STREAM:
 		snprintf(tempStr, sizeof(tempStr) - 1, ">%d", (int)(value.int32Value));
 		break;
@@ -6756,7 +7467,12 @@ static void evalExpression(FlowState *flowState, const uint8_t *instructions, in
                     auto elementIndex = elementIndexValue.toInt32(&err);
                     if (!err) {
                         if (elementIndex >= 0 && elementIndex < (int)array->arraySize) {
-                            g_stack.push(Value::makeArrayElementRef(arrayValue, elementIndex, 0x132e0e2f));
+                            if (detachArrayElement(array, elementIndex)) {
+                                g_stack.push(Value::makeArrayElementRef(arrayValue, elementIndex, 0x132e0e2f));
+                            } else {
+                                g_stack.push(Value::makeError());
+                                g_stack.setErrorMessage("Out of memory\n");
+                            }
                         } else {
                             g_stack.push(Value::makeError());
                             g_stack.setErrorMessage("Array element index out of bounds\n");
@@ -6780,6 +7496,21 @@ static void evalExpression(FlowState *flowState, const uint8_t *instructions, in
                         g_stack.push(Value::makeError());
                         g_stack.setErrorMessage("Integer value expected for blob element index\n");
                     }
+                } else if (arrayValue.isPackedArray()) {
+                    auto packedArray = arrayValue.getPackedArray();
+                    int err;
+                    auto elementIndex = elementIndexValue.toInt32(&err);
+                    if (!err) {
+                        if (elementIndex >= 0 && elementIndex < (int)packedArray->arraySize) {
+                            g_stack.push(Value::makeArrayElementRef(arrayValue, elementIndex, 0x132e0e2f));
+                        } else {
+                            g_stack.push(Value::makeError());
+                            g_stack.setErrorMessage("Array element index out of bounds\n");
+                        }
+                    } else {
+                        g_stack.push(Value::makeError());
+                        g_stack.setErrorMessage("Integer value expected for array element index\n");
+                    }
                 } else {
                     g_stack.push(Value::makeError());
                     g_stack.setErrorMessage("Array value expected\n");
@@ -6925,7 +7656,7 @@ bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, V
         throwError(flowState, componentIndex, flowError);
         return false;
     }
-    auto component = flowState->flow->components[componentIndex];
+    auto component = getComponent(flowState, componentIndex);
     if (propertyIndex < 0 || propertyIndex >= (int)component->properties.count) {
         char message[256];
         snprintf(message, sizeof(message), "invalid property index %d in component at index %d in flow at index %d", propertyIndex, componentIndex, flowState->flowIndex);
@@ -6947,7 +7678,7 @@ bool evalAssignableProperty(FlowState *flowState, int componentIndex, int proper
         throwError(flowState, componentIndex, flowError);
         return false;
     }
-    auto component = flowState->flow->components[componentIndex];
+    auto component = getComponent(flowState, componentIndex);
     if (propertyIndex < 0 || propertyIndex >= (int)component->properties.count) {
         char message[256];
         snprintf(message, sizeof(message), "invalid property index %d in component at index %d in flow at index %d", propertyIndex, componentIndex, flowState->flowIndex);
@@ -7011,6 +7742,7 @@ uint32_t g_wasmModuleId = 0;
 #endif
 static const uint32_t FLOW_TICK_MAX_DURATION_MS = EEZ_FLOW_TICK_MAX_DURATION_MS;
 static unsigned g_tick_max_duration_count = 0;
+static uint32_t g_tickStartTime;
 int g_selectedLanguage = 0;
 FlowState *g_firstFlowState;
 FlowState *g_lastFlowState;
@@ -7025,12 +7757,47 @@ unsigned start(Assets *assets) {
     g_isStopped = false;
     g_isStopping = false;
     initGlobalVariables(assets);
+    initFlowRuntimeInfo(assets);
 	queueReset();
     watchListReset();
+#if defined(EEZ_FOR_LVGL)
+    lvglWaitListReset();
+    lvglPendingWritesReset();
+#endif
 	scpiComponentInitHook();
 	onStarted(assets);
 	return 1;
 }
+#if EEZ_FLOW_LOOP_FUSION
+static bool canFuseTasks(FlowState *flowState, unsigned componentIndex, bool isLastTaskOfTick) {
+    return !flowState->error && !g_debuggerIsConnected && isLastTaskOfTick && g_numNonContinuousTaskInQueue == 0 &&
+        getComponent(flowState, componentIndex)->type == defs_v3::COMPONENT_TYPE_LOOP_ACTION;
+}
+static bool executeFusedTasks(FlowState *flowState) {
+    bool budgetSpent = false;
+    incRefCounterForFlowState(flowState);
+    unsigned componentIndex;
+    for (unsigned i = 1; takeFusedTask(flowState, componentIndex); i++) {
+        flowState->executingComponentIndex = componentIndex;
+        if (flowState->error) {
+            deallocateComponentExecutionState(flowState, componentIndex);
+        } else {
+            executeComponent(flowState, componentIndex);
+        }
+        if (isFlowStopped() || g_isStopping) {
+            break;
+        }
+        resetSequenceInputs(flowState);
+        if (i % 5 == 0 && isTickTimeBudgetSpent()) {
+            budgetSpent = true;
+            break;
+        }
+    }
+    endFusedTasks();
+    decRefCounterForFlowState(flowState);
+    return budgetSpent;
+}
+#endif
 void tick() {
 	if (isFlowStopped()) {
 		return;
@@ -7039,7 +7806,10 @@ void tick() {
         doStop();
         return;
     }
-	uint32_t startTickCount = millis();
+	g_tickStartTime = millis();
+#if defined(EEZ_FOR_LVGL)
+    resetLvglEventCoalescing();
+#endif
     visitWatchList();
     auto queueSizeAtTickStart = getQueueSize();
     for (size_t i = 0; i < queueSizeAtTickStart || g_numNonContinuousTaskInQueue > 0; i++) {
@@ -7056,8 +7826,19 @@ void tick() {
 		if (!continuousTask && !canExecuteStep(flowState, componentIndex)) {
 			break;
 		}
+#if EEZ_FLOW_DUAL_CORE
+        if (!flowState->error && isLvglCoreQueueFull() && mustExecuteOnLvglCore(flowState, componentIndex)) {
+            break;
+        }
+#endif
 		removeNextTaskFromQueue();
         flowState->executingComponentIndex = componentIndex;
+#if EEZ_FLOW_LOOP_FUSION
+        bool fused = !continuousTask && canFuseTasks(flowState, componentIndex, i + 1 >= queueSizeAtTickStart);
+        if (fused) {
+            beginFusedTasks(flowState);
+        }
+#endif
         if (flowState->error) {
             deallocateComponentExecutionState(flowState, componentIndex);
         } else {
@@ -7075,17 +7856,35 @@ void tick() {
             break;
         }
         resetSequenceInputs(flowState);
+#if EEZ_FLOW_LOOP_FUSION
+        bool fusedBudgetSpent = fused && executeFusedTasks(flowState);
+#endif
         if (canFreeFlowState(flowState)) {
             freeFlowState(flowState);
         }
+#if EEZ_FLOW_LOOP_FUSION
+        if (fusedBudgetSpent) {
+            g_tick_max_duration_count++;
+            break;
+        }
+        if (fused && g_isStopping) {
+            break;
+        }
+#endif
         if ((i + 1) % 5 == 0) {
-            if (millis() - startTickCount >= FLOW_TICK_MAX_DURATION_MS) {
+            if (isTickTimeBudgetSpent()) {
                 g_tick_max_duration_count++;
                 break;
             }
         }
 	}
 	finishToDebuggerMessageHook();
+#if defined(EEZ_FOR_LVGL)
+#if !EEZ_FLOW_DUAL_CORE
+    flushLvglLayout();
+#endif
+    updateLvglEventLatency();
+#endif
     for (FlowState *flowState = g_firstFlowState; flowState; flowState = flowState->nextSibling) {
         if (flowState->deleteOnNextTick) {
             freeFlowState(flowState);
@@ -7105,6 +7904,12 @@ void doStop() {
     g_isStopped = true;
 	queueReset();
     watchListReset();
+#if defined(EEZ_FOR_LVGL)
+    lvglWaitListReset();
+    lvglPendingWritesReset();
+#endif
+    flowStatePoolReset();
+    freeFlowRuntimeInfo();
 }
 bool isFlowStopped() {
     return g_isStopped;
@@ -7112,6 +7917,9 @@ bool isFlowStopped() {
 unsigned getTickMaxDurationCounter() {
     return g_tick_max_duration_count;
 }
+bool isTickTimeBudgetSpent() {
+    return millis() - g_tickStartTime >= FLOW_TICK_MAX_DURATION_MS;
+}
 #if EEZ_OPTION_GUI
 FlowState *getPageFlowState(Assets *assets, int16_t pageIndex, const WidgetCursor &widgetCursor) {
 	if (!assets->flowDefinition) {
@@ -7196,6 +8004,7 @@ void setGlobalVariable(Assets *assets, uint32_t globalVariableIndex, const Value
     if (globalVariableIndex < assets->flowDefinition->globalVariables.count) {
         if (g_globalVariables) {
             g_globalVariables->values[globalVariableIndex] = value;
+            g_globalVariables->versions[globalVariableIndex]++;
         } else {
             *assets->flowDefinition->globalVariables[globalVariableIndex] = value;
         }
@@ -7586,6 +8395,9 @@ void (*onFlowErrorHook)(FlowState *flowState, int componentIndex, const char *er
 // -----------------------------------------------------------------------------
 #if defined(EEZ_FOR_LVGL)
 #include <stdio.h>
+#if defined(ESP_PLATFORM)
+#include <esp_heap_caps.h>
+#endif
 static void replacePageHook(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t delay);
 extern "C" void create_screens();
 extern "C" void tick_screen(int screen_index);
@@ -7593,9 +8405,11 @@ static const char **g_screenNames;
 static size_t g_numScreens;
 static lv_obj_t **g_objects;
 static const char **g_objectNames;
+static size_t g_numObjectNames;
 static size_t g_numObjects;
 static lv_group_t **g_groups;
 static const char **g_groupNames;
+static size_t g_numGroupNames;
 static size_t g_numGroups;
 static const char **g_styleNames;
 static size_t g_numStyles;
@@ -7621,45 +8435,80 @@ static lv_group_t *getLvglGroupFromIndex(int32_t index) {
     }
     return 0;
 }
-static int32_t getLvglScreenByName(const char *name) {
-    for (size_t i = 0; i < g_numScreens; i++) {
-        if (strcmp(g_screenNames[i], name) == 0) {
-            return i + 1;
+struct NameIndex {
+    uint16_t *slots;
+    uint32_t mask;
+};
+static NameIndex g_screenNameIndex;
+static NameIndex g_objectNameIndex;
+static NameIndex g_groupNameIndex;
+static NameIndex g_styleNameIndex;
+static NameIndex g_imageNameIndex;
+static inline uint32_t hashName(const char *name) {
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+    return hash;
+}
+static inline const char *getNameAt(const void *names, size_t stride, size_t i) {
+    return *(const char * const *)((const uint8_t *)names + i * stride);
+}
+static void resetNameIndex(NameIndex &index) {
+    if (index.slots) {
+        eez::free(index.slots);
+        index.slots = nullptr;
+    }
+}
+static int32_t findName(NameIndex &index, const void *names, size_t stride, size_t count, const char *name) {
+    if (!index.slots && count > 0 && count < 0x8000) {
+        uint32_t numSlots = 8;
+        while (numSlots < 2 * count) {
+            numSlots <<= 1;
+        }
+        index.slots = (uint16_t *)eez::alloc(numSlots * sizeof(uint16_t), 0x6b1d94e3);
+        if (index.slots) {
+            memset(index.slots, 0, numSlots * sizeof(uint16_t));
+            index.mask = numSlots - 1;
+        }
+    }
+    uint32_t slot = 0;
+    if (index.slots) {
+        slot = hashName(name) & index.mask;
+        while (index.slots[slot]) {
+            int32_t i = index.slots[slot] - 1;
+            if (strcmp(getNameAt(names, stride, i), name) == 0) {
+                return i;
+            }
+            slot = (slot + 1) & index.mask;
         }
     }
-    return -1;
-}
-static int32_t getLvglObjectByName(const char *name) {
-    for (size_t i = 0; i < g_numObjects; i++) {
-        if (strcmp(g_objectNames[i], name) == 0) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(getNameAt(names, stride, i), name) == 0) {
+            if (index.slots) {
+                index.slots[slot] = (uint16_t)(i + 1);
+            }
             return i;
         }
     }
     return -1;
 }
+static int32_t getLvglScreenByName(const char *name) {
+    int32_t i = findName(g_screenNameIndex, g_screenNames, sizeof(const char *), g_numScreens, name);
+    return i != -1 ? i + 1 : -1;
+}
+static int32_t getLvglObjectByName(const char *name) {
+    return findName(g_objectNameIndex, g_objectNames, sizeof(const char *), g_numObjectNames, name);
+}
 static int32_t getLvglGroupByName(const char *name) {
-    for (size_t i = 0; i < g_numGroups; i++) {
-        if (strcmp(g_groupNames[i], name) == 0) {
-            return i;
-        }
-    }
-    return -1;
+    return findName(g_groupNameIndex, g_groupNames, sizeof(const char *), g_numGroupNames, name);
 }
 static int32_t getLvglStyleByName(const char *name) {
-    for (size_t i = 0; i < g_numStyles; i++) {
-        if (strcmp(g_styleNames[i], name) == 0) {
-            return i;
-        }
-    }
-    return -1;
+    return findName(g_styleNameIndex, g_styleNames, sizeof(const char *), g_numStyles, name);
 }
 static const void *getLvglImageByName(const char *name) {
-    for (size_t i = 0; i < g_numImages; i++) {
-        if (strcmp(g_images[i].name, name) == 0) {
-            return g_images[i].img_dsc;
-        }
-    }
-    return 0;
+    int32_t i = findName(g_imageNameIndex, g_images ? &g_images[0].name : nullptr, sizeof(ext_img_desc_t), g_numImages, name);
+    return i != -1 ? g_images[i].img_dsc : 0;
 }
 uint8_t g_lastLVGLEventUserDataBuffer[64];
 uint8_t g_lastLVGLEventParamBuffer[64];
@@ -7667,74 +8516,568 @@ static lv_event_t g_lastLVGLEvent;
 static void executeLvglAction(int actionIndex) {
     g_actions[actionIndex](&g_lastLVGLEvent);
 }
-void eez_flow_init_themes(const char **themeNames, size_t numThemes, void (*changeColorTheme)(uint32_t themeIndex)) {
-    g_themeNames = themeNames;
-    g_numThemes = numThemes;
-    g_changeColorTheme = changeColorTheme;
-}
-void eez_flow_set_create_screen_func(void (*createScreenFunc)(int screenIndex)) {
-    g_createScreenFunc = createScreenFunc;
-}
-void eez_flow_set_delete_screen_func(void (*deleteScreenFunc)(int screenIndex)) {
-    g_deleteScreenFunc = deleteScreenFunc;
-}
-static void lvglSetColorTheme(const char *themeName) {
-    for (uint32_t i = 0; i < g_numThemes; i++) {
-        if (strcmp(themeName, g_themeNames[i]) == 0) {
-            g_selectedThemeIndex = i;
-            if (g_changeColorTheme) {
-                g_changeColorTheme(g_selectedThemeIndex);
-            }
-            return;
+#ifndef EEZ_FLOW_LVGL_EVENT_POOL_SIZE
+#define EEZ_FLOW_LVGL_EVENT_POOL_SIZE 16
+#endif
+#ifndef EEZ_FLOW_LVGL_EVENT_COALESCING
+#define EEZ_FLOW_LVGL_EVENT_COALESCING 0
+#endif
+#ifndef EEZ_FLOW_LVGL_EVENT_COALESCE_SLOTS
+#define EEZ_FLOW_LVGL_EVENT_COALESCE_SLOTS 8
+#endif
+#if EEZ_FLOW_DUAL_CORE
+#include "freertos/FreeRTOS.h"
+static portMUX_TYPE g_lvglEventPoolLock = portMUX_INITIALIZER_UNLOCKED;
+#define LVGL_EVENT_POOL_LOCK() portENTER_CRITICAL(&g_lvglEventPoolLock)
+#define LVGL_EVENT_POOL_UNLOCK() portEXIT_CRITICAL(&g_lvglEventPoolLock)
+#else
+#define LVGL_EVENT_POOL_LOCK()
+#define LVGL_EVENT_POOL_UNLOCK()
+#endif
+union LVGLEventPoolBlock {
+    LVGLEventPoolBlock *next;
+    alignas(eez::LVGLEventRef) uint8_t storage[sizeof(eez::LVGLEventRef)];
+};
+static LVGLEventPoolBlock g_lvglEventPool[EEZ_FLOW_LVGL_EVENT_POOL_SIZE];
+static LVGLEventPoolBlock *g_lvglEventPoolFree;
+static bool g_lvglEventPoolInitialized;
+static eez_flow_event_stats_t g_eventStats;
+static bool g_lvglEventCoalescing = EEZ_FLOW_LVGL_EVENT_COALESCING;
+struct CoalescedLVGLEvent {
+    void *flowState;
+    unsigned componentIndex;
+    unsigned outputIndex;
+    eez::Value eventValue;
+};
+static CoalescedLVGLEvent g_coalescedLvglEvents[EEZ_FLOW_LVGL_EVENT_COALESCE_SLOTS];
+static uint32_t g_numCoalescedLvglEvents;
+static bool g_hasPendingLvglEvent;
+static uint32_t g_pendingLvglEventTime;
+namespace eez {
+LVGLEventRef *allocLVGLEventRef(uint32_t id) {
+    LVGL_EVENT_POOL_LOCK();
+    if (!g_lvglEventPoolInitialized) {
+        for (uint32_t i = 0; i < EEZ_FLOW_LVGL_EVENT_POOL_SIZE; i++) {
+            g_lvglEventPool[i].next = i + 1 < EEZ_FLOW_LVGL_EVENT_POOL_SIZE ? &g_lvglEventPool[i + 1] : nullptr;
         }
+        g_lvglEventPoolFree = &g_lvglEventPool[0];
+        g_lvglEventPoolInitialized = true;
     }
+    auto block = g_lvglEventPoolFree;
+    if (block) {
+        g_lvglEventPoolFree = block->next;
+    }
+    LVGL_EVENT_POOL_UNLOCK();
+    if (!block) {
+        g_eventStats.numPoolMisses++;
+        return ObjectAllocator<LVGLEventRef>::allocate(id);
+    }
+    return new (block) LVGLEventRef;
 }
-#if !defined(EEZ_LVGL_SCREEN_STACK_SIZE)
-#define EEZ_LVGL_SCREEN_STACK_SIZE 10
-#endif
-int16_t g_screenStack[EEZ_LVGL_SCREEN_STACK_SIZE];
-unsigned g_screenStackPosition = 0;
-extern "C" int16_t eez_flow_get_current_screen() {
-    return g_currentScreen + 1;
-}
-static bool isScreenCreated(int screenIndex) {
-    return eez::flow::getLvglObjectFromIndexHook(screenIndex) != 0;
+void freeLVGLEventRef(Ref *ref) {
+    auto block = (LVGLEventPoolBlock *)ref;
+    if (block < g_lvglEventPool || block >= g_lvglEventPool + EEZ_FLOW_LVGL_EVENT_POOL_SIZE) {
+        ObjectAllocator<Ref>::deallocate(ref);
+        return;
+    }
+    ref->~Ref();
+    LVGL_EVENT_POOL_LOCK();
+    block->next = g_lvglEventPoolFree;
+    g_lvglEventPoolFree = block;
+    LVGL_EVENT_POOL_UNLOCK();
 }
-static void createScreen(int screenIndex) {
-    if (g_createScreenFunc && !isScreenCreated(screenIndex)) {
-        g_createScreenFunc(screenIndex);
+namespace flow {
+void resetLvglEventCoalescing() {
+    for (uint32_t i = 0; i < g_numCoalescedLvglEvents; i++) {
+        g_coalescedLvglEvents[i].eventValue = Value();
     }
+    g_numCoalescedLvglEvents = 0;
 }
-static void deleteScreen(int screenIndex) {
-    if (g_deleteScreenFunc && isScreenCreated(screenIndex)) {
-        g_deleteScreenFunc(screenIndex);
+void updateLvglEventLatency() {
+    if (g_hasPendingLvglEvent && g_numNonContinuousTaskInQueue == 0) {
+        g_eventStats.lastLatency = millis() - g_pendingLvglEventTime;
+        if (g_eventStats.lastLatency > g_eventStats.maxLatency) {
+            g_eventStats.maxLatency = g_eventStats.lastLatency;
+        }
+        g_hasPendingLvglEvent = false;
     }
 }
-extern "C" void eez_flow_set_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
-    g_screenStackPosition = 0;
-    eez::flow::replacePageHook(screenId, animType, speed, delay);
+} 
+} 
+static bool isCoalescableLvglEvent(const eez::Value &eventValue) {
+    if (!g_lvglEventCoalescing || eventValue.type != eez::VALUE_TYPE_EVENT) {
+        return false;
+    }
+    auto event = eventValue.getLVGLEventRef();
+    return event->key == 0 && (event->code == LV_EVENT_PRESSING || event->code == LV_EVENT_SCROLL || event->code == LV_EVENT_VALUE_CHANGED);
 }
-extern "C" void eez_flow_push_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
-    if (g_screenStackPosition == EEZ_LVGL_SCREEN_STACK_SIZE) {
-        for (unsigned i = 1; i < EEZ_LVGL_SCREEN_STACK_SIZE; i++) {
-            g_screenStack[i - 1] = g_screenStack[i];
+static bool coalesceLvglEvent(void *flowState, unsigned componentIndex, unsigned outputIndex, const eez::Value &eventValue) {
+    auto event = eventValue.getLVGLEventRef();
+    for (uint32_t i = 0; i < g_numCoalescedLvglEvents; i++) {
+        auto &pending = g_coalescedLvglEvents[i];
+        if (pending.flowState != flowState || pending.componentIndex != componentIndex || pending.outputIndex != outputIndex) {
+            continue;
         }
-        g_screenStackPosition--;
+        auto pendingEvent = pending.eventValue.getLVGLEventRef();
+        if (pendingEvent->code != event->code || pendingEvent->currentTarget != event->currentTarget) {
+            continue;
+        }
+        bool coalesced = eez::flow::replaceQueuedValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex, pending.eventValue, eventValue);
+        pending.eventValue = eventValue;
+        if (coalesced) {
+            g_eventStats.numCoalescedEvents++;
+        }
+        return coalesced;
     }
-    g_screenStack[g_screenStackPosition++] = g_currentScreen + 1;
-    eez::flow::replacePageHook(screenId, animType, speed, delay);
-}
-extern "C" void eez_flow_pop_screen(lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
-    if (g_screenStackPosition > 0) {
-        g_screenStackPosition--;
-        eez::flow::replacePageHook(g_screenStack[g_screenStackPosition], animType, speed, delay);
+    if (g_numCoalescedLvglEvents < EEZ_FLOW_LVGL_EVENT_COALESCE_SLOTS) {
+        auto &pending = g_coalescedLvglEvents[g_numCoalescedLvglEvents++];
+        pending.flowState = flowState;
+        pending.componentIndex = componentIndex;
+        pending.outputIndex = outputIndex;
+        pending.eventValue = eventValue;
     }
+    return false;
 }
-void eez_flow_create_screen(int16_t screenId) {
-    int16_t screenIndex = screenId - 1;
-    createScreen(screenIndex);
+static void onLvglEventDelivered(const eez::Value &eventValue) {
+    if (!g_hasPendingLvglEvent && eventValue.type == eez::VALUE_TYPE_EVENT) {
+        g_hasPendingLvglEvent = true;
+        g_pendingLvglEventTime = eventValue.getLVGLEventRef()->time;
+    }
 }
-void eez_flow_delete_screen(int16_t screenId) {
+#if EEZ_FLOW_DUAL_CORE
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#if LV_USE_OS == 0
+#error "EEZ_FLOW_DUAL_CORE requires LV_USE_OS"
+#endif
+#ifndef EEZ_FLOW_TASK_CORE
+#define EEZ_FLOW_TASK_CORE 1
+#endif
+#ifndef EEZ_FLOW_TASK_PRIORITY
+#define EEZ_FLOW_TASK_PRIORITY 4
+#endif
+#ifndef EEZ_FLOW_TASK_STACK_SIZE
+#define EEZ_FLOW_TASK_STACK_SIZE 8192
+#endif
+#ifndef EEZ_FLOW_TASK_PERIOD_MS
+#define EEZ_FLOW_TASK_PERIOD_MS 5
+#endif
+#ifndef EEZ_FLOW_LVGL_CORE_QUEUE_SIZE
+#define EEZ_FLOW_LVGL_CORE_QUEUE_SIZE 64
+#endif
+#ifndef EEZ_FLOW_EVENT_QUEUE_SIZE
+#define EEZ_FLOW_EVENT_QUEUE_SIZE 32
+#endif
+namespace eez {
+namespace flow {
+struct PostedComponent {
+    FlowState *flowState;
+    unsigned componentIndex;
+};
+struct PostedEvent {
+    FlowState *flowState;
+    unsigned componentIndex;
+    unsigned outputIndex;
+    bool hasValue;
+    Value value;
+    bool hasLvglEvent;
+    lv_event_t event;
+    uint8_t userDataBuffer[sizeof(g_lastLVGLEventUserDataBuffer)];
+    uint8_t paramBuffer[sizeof(g_lastLVGLEventParamBuffer)];
+};
+static SpscQueue<PostedComponent, EEZ_FLOW_LVGL_CORE_QUEUE_SIZE> g_lvglCoreQueue;
+static SpscQueue<PostedEvent, EEZ_FLOW_EVENT_QUEUE_SIZE> g_eventQueue;
+static SemaphoreHandle_t g_flowMutex;
+static uint32_t g_flowLockDepth;
+static TaskHandle_t g_flowTaskHandle;
+bool g_isExecutingOnLvglCore;
+void initFlowLock() {
+    if (!g_flowMutex) {
+        g_flowMutex = xSemaphoreCreateRecursiveMutex();
+    }
+}
+void lockFlow() {
+    xSemaphoreTakeRecursive(g_flowMutex, portMAX_DELAY);
+    g_flowLockDepth++;
+}
+void unlockFlow() {
+    g_flowLockDepth--;
+    xSemaphoreGiveRecursive(g_flowMutex);
+}
+static bool isFlowLockedByCurrentTask() {
+    return g_flowMutex && xSemaphoreGetMutexHolder(g_flowMutex) == xTaskGetCurrentTaskHandle();
+}
+static void yieldFlowLock() {
+    auto depth = g_flowLockDepth;
+    for (uint32_t i = 0; i < depth; i++) {
+        unlockFlow();
+    }
+    vTaskDelay(1);
+    for (uint32_t i = 0; i < depth; i++) {
+        lockFlow();
+    }
+}
+bool isLvglCoreQueueFull() {
+    return g_lvglCoreQueue.isFull();
+}
+void postToLvglCore(FlowState *flowState, unsigned componentIndex) {
+    incRefCounterForFlowState(flowState);
+    auto item = g_lvglCoreQueue.beginPush();
+    while (!item) {
+        yieldFlowLock();
+        item = g_lvglCoreQueue.beginPush();
+    }
+    item->flowState = flowState;
+    item->componentIndex = componentIndex;
+    g_lvglCoreQueue.endPush();
+    flowState->executingComponentIndex = NO_COMPONENT_INDEX;
+}
+void executePostedOnLvglCore() {
+    g_isExecutingOnLvglCore = true;
+    for (auto item = g_lvglCoreQueue.front(); item; item = g_lvglCoreQueue.front()) {
+        auto flowState = item->flowState;
+        auto componentIndex = item->componentIndex;
+        g_lvglCoreQueue.pop();
+        if (!flowState) {
+            continue;
+        }
+        decRefCounterForFlowState(flowState);
+        if (!flowState->error) {
+            flowState->executingComponentIndex = componentIndex;
+            executeComponent(flowState, componentIndex);
+            if (isFlowStopped()) {
+                break;
+            }
+            resetSequenceInputs(flowState);
+        }
+        if (canFreeFlowState(flowState)) {
+            freeFlowState(flowState);
+        }
+    }
+    flushLvglLayout();
+    g_isExecutingOnLvglCore = false;
+}
+static void postEvent(void *flowState, unsigned componentIndex, unsigned outputIndex, const Value *value, lv_event_t *event) {
+    auto item = g_eventQueue.beginPush();
+    while (!item) {
+        if (isFlowLockedByCurrentTask()) {
+            executePostedEvents();
+        } else {
+            vTaskDelay(1);
+        }
+        item = g_eventQueue.beginPush();
+    }
+    item->flowState = (FlowState *)flowState;
+    item->componentIndex = componentIndex;
+    item->outputIndex = outputIndex;
+    item->hasValue = value != nullptr;
+    if (value) {
+        item->value = *value;
+    }
+    item->hasLvglEvent = event != nullptr;
+    if (event) {
+        item->event = *event;
+        if (event->user_data) {
+            memcpy(item->userDataBuffer, event->user_data, sizeof(item->userDataBuffer));
+        }
+        if (event->param) {
+            memcpy(item->paramBuffer, event->param, sizeof(item->paramBuffer));
+        }
+    }
+    g_eventQueue.endPush();
+}
+static bool hasNewerPostedEvent(PostedEvent *item) {
+    auto event = item->value.getLVGLEventRef();
+    bool newer = false;
+    g_eventQueue.forEachPending([item, event, &newer](PostedEvent &other) {
+        if (
+            &other != item && other.flowState == item->flowState &&
+            other.componentIndex == item->componentIndex && other.outputIndex == item->outputIndex &&
+            other.hasValue && other.value.type == VALUE_TYPE_EVENT &&
+            other.value.getLVGLEventRef()->code == event->code &&
+            other.value.getLVGLEventRef()->currentTarget == event->currentTarget
+        ) {
+            newer = true;
+        }
+    });
+    return newer;
+}
+void executePostedEvents() {
+    for (auto item = g_eventQueue.front(); item; item = g_eventQueue.front()) {
+        if (item->flowState && item->hasValue && isCoalescableLvglEvent(item->value)) {
+            onLvglEventDelivered(item->value);
+            if (hasNewerPostedEvent(item)) {
+                g_eventStats.numCoalescedEvents++;
+                item->value = Value();
+                g_eventQueue.pop();
+                continue;
+            }
+        }
+        if (item->flowState) {
+            if (item->hasValue) {
+                propagateValue(item->flowState, item->componentIndex, item->outputIndex, item->value);
+            } else {
+                propagateValue(item->flowState, item->componentIndex, item->outputIndex);
+            }
+            if (item->hasLvglEvent) {
+                g_lastLVGLEvent = item->event;
+                if (item->event.user_data) {
+                    g_lastLVGLEvent.user_data = &g_lastLVGLEventUserDataBuffer;
+                    memcpy(&g_lastLVGLEventUserDataBuffer, item->userDataBuffer, sizeof(g_lastLVGLEventUserDataBuffer));
+                }
+                if (item->event.param) {
+                    g_lastLVGLEvent.param = &g_lastLVGLEventParamBuffer;
+                    memcpy(&g_lastLVGLEventParamBuffer, item->paramBuffer, sizeof(g_lastLVGLEventParamBuffer));
+                }
+            }
+        }
+        item->value = Value();
+        g_eventQueue.pop();
+    }
+}
+void removePostedForFlowState(FlowState *flowState) {
+    g_lvglCoreQueue.forEachPending([flowState](PostedComponent &item) {
+        if (item.flowState == flowState) {
+            item.flowState = nullptr;
+        }
+    });
+    g_eventQueue.forEachPending([flowState](PostedEvent &item) {
+        if (item.flowState == flowState) {
+            item.flowState = nullptr;
+        }
+    });
+}
+static void flowTask(void *) {
+    TickType_t period = pdMS_TO_TICKS(EEZ_FLOW_TASK_PERIOD_MS);
+    while (true) {
+        lockFlow();
+        executePostedEvents();
+        tick();
+        unlockFlow();
+        vTaskDelay(period > 0 ? period : 1);
+    }
+}
+void startFlowTask() {
+    if (!g_flowTaskHandle) {
+        xTaskCreatePinnedToCore(flowTask, "eez_flow", EEZ_FLOW_TASK_STACK_SIZE, nullptr, EEZ_FLOW_TASK_PRIORITY, &g_flowTaskHandle, EEZ_FLOW_TASK_CORE);
+    }
+}
+} 
+} 
+#endif
+void eez_flow_init_themes(const char **themeNames, size_t numThemes, void (*changeColorTheme)(uint32_t themeIndex)) {
+    g_themeNames = themeNames;
+    g_numThemes = numThemes;
+    g_changeColorTheme = changeColorTheme;
+}
+void eez_flow_set_create_screen_func(void (*createScreenFunc)(int screenIndex)) {
+    g_createScreenFunc = createScreenFunc;
+}
+void eez_flow_set_delete_screen_func(void (*deleteScreenFunc)(int screenIndex)) {
+    g_deleteScreenFunc = deleteScreenFunc;
+}
+static void lvglSetColorTheme(const char *themeName) {
+    for (uint32_t i = 0; i < g_numThemes; i++) {
+        if (strcmp(themeName, g_themeNames[i]) == 0) {
+            g_selectedThemeIndex = i;
+            if (g_changeColorTheme) {
+                g_changeColorTheme(g_selectedThemeIndex);
+            }
+            return;
+        }
+    }
+}
+#if !defined(EEZ_LVGL_SCREEN_STACK_SIZE)
+#define EEZ_LVGL_SCREEN_STACK_SIZE 10
+#endif
+int16_t g_screenStack[EEZ_LVGL_SCREEN_STACK_SIZE];
+unsigned g_screenStackPosition = 0;
+extern "C" int16_t eez_flow_get_current_screen() {
+    return g_currentScreen + 1;
+}
+static bool isScreenCreated(int screenIndex) {
+    return eez::flow::getLvglObjectFromIndexHook(screenIndex) != 0;
+}
+#ifndef EEZ_FLOW_SCREEN_CACHE_BUDGET
+#define EEZ_FLOW_SCREEN_CACHE_BUDGET 0
+#endif
+#ifndef EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS
+#define EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS 32
+#endif
+static_assert(EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS <= 32, "screen neighbours are stored as a 32-bit mask");
+struct ScreenCacheEntry {
+    uint32_t neighbours;
+    uint32_t lastUsed;
+    eez_flow_screen_stats_t stats;
+};
+static ScreenCacheEntry g_screenCache[EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS];
+static size_t g_screenCacheBudget = EEZ_FLOW_SCREEN_CACHE_BUDGET;
+static uint32_t g_screenCacheClock;
+static uint32_t getNumCachedScreens() {
+    return g_numScreens < EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS ? g_numScreens : EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS;
+}
+static ScreenCacheEntry *getScreenCacheEntry(int screenIndex) {
+    if (screenIndex >= 0 && (uint32_t)screenIndex < EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS) {
+        return &g_screenCache[screenIndex];
+    }
+    return nullptr;
+}
+static size_t getScreenMemoryUsed() {
+    uint32_t free;
+    uint32_t alloc;
+    eez::getAllocInfo(free, alloc);
+    size_t used = alloc;
+#if defined(ESP_PLATFORM)
+    used += heap_caps_get_total_size(MALLOC_CAP_DEFAULT) - heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+#endif
+    return used;
+}
+static size_t getScreenCacheUsed() {
+    size_t used = 0;
+    for (uint32_t i = 0; i < getNumCachedScreens(); i++) {
+        if (isScreenCreated(i)) {
+            used += g_screenCache[i].stats.memSize;
+        }
+    }
+    return used;
+}
+static void createScreen(int screenIndex) {
+    if (g_createScreenFunc && !isScreenCreated(screenIndex)) {
+        // the flow task allocates only while it holds the flow lock, so holding it here keeps
+        // the flow task's allocations out of the heap delta measured around the create
+        EEZ_FLOW_LOCK();
+        auto entry = getScreenCacheEntry(screenIndex);
+        size_t memBefore = entry ? getScreenMemoryUsed() : 0;
+        uint32_t startTime = lv_tick_get();
+        g_createScreenFunc(screenIndex);
+        if (entry) {
+            size_t memAfter = getScreenMemoryUsed();
+            entry->stats.memSize = memAfter > memBefore ? memAfter - memBefore : 0;
+            entry->stats.createTime = lv_tick_elaps(startTime);
+            entry->stats.numCreates++;
+        }
+        eez::flow::onLvglObjectsCreated();
+    }
+}
+static void deleteScreenObjects(int screenIndex) {
+    lv_obj_t *screen = eez::flow::getLvglObjectFromIndexHook(screenIndex);
+    // the objects table is passed as sizeof(objects)
+    size_t numObjects = g_numObjects / sizeof(lv_obj_t *);
+    for (size_t i = 0; i < numObjects; i++) {
+        if (g_objects[i] && lv_obj_get_screen(g_objects[i]) == screen) {
+            g_objects[i] = nullptr;
+        }
+    }
+    // async, because deleteScreen() can run from the screen's own LV_EVENT_SCREEN_UNLOADED
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_delete_async(screen);
+#else
+    lv_obj_del_async(screen);
+#endif
+    deletePageFlowState(screenIndex);
+}
+static void deleteScreen(int screenIndex) {
+    if (isScreenCreated(screenIndex)) {
+        eez::flow::flushLvglLayout();
+        if (g_deleteScreenFunc) {
+            g_deleteScreenFunc(screenIndex);
+        } else if (g_createScreenFunc) {
+            // only a screen that can be created again is deleted without a delete function
+            deleteScreenObjects(screenIndex);
+        }
+    }
+}
+// An evicted screen loses only its LVGL objects. Its page flow state stays alive, so page
+// variables and running actions survive, and the screen reattaches to it when re-created.
+static bool g_keepPageFlowStateOnDelete;
+static void evictScreens(int keepScreenIndex1, int keepScreenIndex2) {
+    if (g_screenCacheBudget == 0 || !g_createScreenFunc) {
+        return;
+    }
+    size_t used = getScreenCacheUsed();
+    while (used > g_screenCacheBudget) {
+        int lruScreenIndex = -1;
+        for (uint32_t i = 0; i < getNumCachedScreens(); i++) {
+            if (
+                (int)i != keepScreenIndex1 && (int)i != keepScreenIndex2 && isScreenCreated(i) &&
+                eez::flow::getLvglObjectFromIndexHook(i) != lv_scr_act() &&
+                (lruScreenIndex == -1 || g_screenCache[i].lastUsed < g_screenCache[lruScreenIndex].lastUsed)
+            ) {
+                lruScreenIndex = i;
+            }
+        }
+        if (lruScreenIndex == -1) {
+            break;
+        }
+        used -= g_screenCache[lruScreenIndex].stats.memSize;
+        g_keepPageFlowStateOnDelete = true;
+        deleteScreen(lruScreenIndex);
+        g_keepPageFlowStateOnDelete = false;
+    }
+}
+static bool preCreateScreen(int screenIndex, size_t used) {
+    auto entry = getScreenCacheEntry(screenIndex);
+    if (!entry || (uint32_t)screenIndex >= getNumCachedScreens() || isScreenCreated(screenIndex)) {
+        return false;
+    }
+    if (used >= g_screenCacheBudget || used + entry->stats.memSize > g_screenCacheBudget) {
+        return false;
+    }
+    entry->lastUsed = g_screenCacheClock;
+    createScreen(screenIndex);
+    return true;
+}
+static void preCreateScreens() {
+    if (g_screenCacheBudget == 0 || !g_createScreenFunc || g_currentScreen < 0 || eez::flow::isFlowStopped()) {
+        return;
+    }
+    if (eez::flow::g_numNonContinuousTaskInQueue > 0 || lv_anim_count_running() > 0) {
+        return;
+    }
+    size_t used = getScreenCacheUsed();
+    for (unsigned i = g_screenStackPosition; i-- > 0; ) {
+        if (preCreateScreen(g_screenStack[i] - 1, used)) {
+            return;
+        }
+    }
+    auto entry = getScreenCacheEntry(g_currentScreen);
+    if (entry) {
+        for (uint32_t i = 0; i < EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS; i++) {
+            if ((entry->neighbours & (1u << i)) && preCreateScreen(i, used)) {
+                return;
+            }
+        }
+    }
+}
+extern "C" void eez_flow_set_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
+    EEZ_FLOW_LOCK();
+    g_screenStackPosition = 0;
+    eez::flow::replacePageHook(screenId, animType, speed, delay);
+}
+extern "C" void eez_flow_push_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
+    EEZ_FLOW_LOCK();
+    if (g_screenStackPosition == EEZ_LVGL_SCREEN_STACK_SIZE) {
+        for (unsigned i = 1; i < EEZ_LVGL_SCREEN_STACK_SIZE; i++) {
+            g_screenStack[i - 1] = g_screenStack[i];
+        }
+        g_screenStackPosition--;
+    }
+    g_screenStack[g_screenStackPosition++] = g_currentScreen + 1;
+    eez::flow::replacePageHook(screenId, animType, speed, delay);
+}
+extern "C" void eez_flow_pop_screen(lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
+    EEZ_FLOW_LOCK();
+    if (g_screenStackPosition > 0) {
+        g_screenStackPosition--;
+        eez::flow::replacePageHook(g_screenStack[g_screenStackPosition], animType, speed, delay);
+    }
+}
+void eez_flow_create_screen(int16_t screenId) {
+    int16_t screenIndex = screenId - 1;
+    createScreen(screenIndex);
+}
+void eez_flow_delete_screen(int16_t screenId) {
     int16_t screenIndex = screenId - 1;
     deleteScreen(screenIndex);
 }
@@ -7756,16 +9099,58 @@ void eez_flow_delete_screen_on_unload(int screenIndex) {
         (void*)(lv_uintptr_t)(screenIndex)
     );
 }
+void eez_flow_set_event_coalescing(bool enable) {
+    EEZ_FLOW_LOCK();
+    g_lvglEventCoalescing = enable;
+    if (!enable) {
+        eez::flow::resetLvglEventCoalescing();
+    }
+}
+void eez_flow_get_event_stats(eez_flow_event_stats_t *stats) {
+    *stats = g_eventStats;
+    stats->maxQueueSize = eez::flow::getMaxQueueSize();
+}
+void eez_flow_reset_event_stats() {
+    memset(&g_eventStats, 0, sizeof(g_eventStats));
+}
+void eez_flow_set_screen_cache_budget(size_t budget) {
+    g_screenCacheBudget = budget;
+}
+void eez_flow_set_screen_neighbours(int16_t screenId, const int16_t *neighbourScreenIds, size_t numNeighbours) {
+    auto entry = getScreenCacheEntry(screenId - 1);
+    if (!entry) {
+        return;
+    }
+    entry->neighbours = 0;
+    for (size_t i = 0; i < numNeighbours; i++) {
+        int16_t neighbourIndex = neighbourScreenIds[i] - 1;
+        if (neighbourIndex >= 0 && neighbourIndex < EEZ_FLOW_SCREEN_CACHE_MAX_SCREENS) {
+            entry->neighbours |= 1u << neighbourIndex;
+        }
+    }
+}
+bool eez_flow_get_screen_stats(int16_t screenId, eez_flow_screen_stats_t *stats) {
+    auto entry = getScreenCacheEntry(screenId - 1);
+    if (!entry) {
+        return false;
+    }
+    *stats = entry->stats;
+    return true;
+}
 extern "C" void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj_t **objects, size_t numObjects, const ext_img_desc_t *images, size_t numImages, ActionExecFunc *actions) {
     g_objects = objects;
     g_numObjects = numObjects;
     g_images = images;
     g_numImages = numImages;
     g_actions = actions;
+    resetNameIndex(g_imageNameIndex);
     eez::initAssetsMemory();
     eez::loadMainAssets(assets, assetsSize);
     eez::initOtherMemory();
     eez::initAllocHeap(eez::ALLOC_BUFFER, eez::ALLOC_BUFFER_SIZE);
+#if EEZ_FLOW_DUAL_CORE
+    eez::flow::initFlowLock();
+#endif
     eez::flow::replacePageHook = replacePageHook;
     eez::flow::getLvglObjectFromIndexHook = getLvglObjectFromIndex;
     eez::flow::getLvglScreenByNameHook = getLvglScreenByName;
@@ -7779,6 +9164,9 @@ extern "C" void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj
     eez::flow::start(eez::g_mainAssets);
     create_screens();
     replacePageHook(1, 0, 0, 0);
+#if EEZ_FLOW_DUAL_CORE
+    eez::flow::startFlowTask();
+#endif
 }
 extern "C" void eez_flow_init_styles(
     void (*add_style)(lv_obj_t *obj, int32_t styleIndex),
@@ -7794,52 +9182,94 @@ void eez_flow_init_groups(lv_group_t **groups, size_t numGroups) {
 void eez_flow_init_screen_names(const char **screenNames, size_t numScreens) {
     g_screenNames = screenNames;
     g_numScreens = numScreens;
+    resetNameIndex(g_screenNameIndex);
 }
 void eez_flow_init_object_names(const char **objectNames, size_t numObjects) {
     g_objectNames = objectNames;
-    EEZ_UNUSED(numObjects);
+    g_numObjectNames = numObjects;
+    resetNameIndex(g_objectNameIndex);
 }
 void eez_flow_init_group_names(const char **groupNames, size_t numGroups) {
     g_groupNames = groupNames;
-    EEZ_UNUSED(numGroups);
+    g_numGroupNames = numGroups;
+    resetNameIndex(g_groupNameIndex);
 }
 void eez_flow_init_style_names(const char **styleNames, size_t numStyles) {
     g_styleNames = styleNames;
     g_numStyles = numStyles;
+    resetNameIndex(g_styleNameIndex);
 }
 extern "C" void eez_flow_tick() {
+#if EEZ_FLOW_DUAL_CORE
+    EEZ_FLOW_LOCK();
+    eez::flow::executePostedOnLvglCore();
+#else
     eez::flow::tick();
+#endif
+    preCreateScreens();
 }
 extern "C" bool eez_flow_is_stopped() {
     return eez::flow::isFlowStopped();
 }
+extern "C" void eez_flow_native_var_changed() {
+    eez::flow::onNativeVariableAssigned();
+}
 namespace eez {
 ActionExecFunc g_actionExecFunctions[] = { 0 };
 }
 void replacePageHook(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t delay) {
     int16_t screenIndex = pageId - 1;
+    uint32_t startTime = lv_tick_get();
+    bool cacheHit = isScreenCreated(screenIndex);
     createScreen(screenIndex);
     lv_obj_t *screen = eez::flow::getLvglObjectFromIndexHook(screenIndex);
     if (!screen) {
         return;
     }
     eez::flow::onPageChanged(g_currentScreen + 1, pageId);
+    int16_t previousScreenIndex = g_currentScreen;
     g_currentScreen = screenIndex;
     lv_scr_load_anim(screen, (lv_scr_load_anim_t)animType, speed, delay, false);
+    auto entry = getScreenCacheEntry(screenIndex);
+    if (entry) {
+        entry->lastUsed = ++g_screenCacheClock;
+        entry->stats.navigationTime = lv_tick_elaps(startTime);
+        entry->stats.numNavigations++;
+        if (cacheHit) {
+            entry->stats.numCacheHits++;
+        }
+    }
+    evictScreens(screenIndex, previousScreenIndex);
 }
 extern "C" void flowOnPageLoaded(unsigned pageIndex) {
+    EEZ_FLOW_LOCK();
     eez::flow::getPageFlowState(eez::g_mainAssets, pageIndex);
 }
 extern "C" void flowPropagateValue(void *flowState, unsigned componentIndex, unsigned outputIndex) {
+#if EEZ_FLOW_DUAL_CORE
+    eez::flow::postEvent(flowState, componentIndex, outputIndex, nullptr, nullptr);
+#else
     eez::flow::propagateValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex);
+#endif
 }
 extern "C" void flowPropagateValueInt32(void *flowState, unsigned componentIndex, unsigned outputIndex, int32_t value) {
+#if EEZ_FLOW_DUAL_CORE
+    eez::Value postedValue((int)value, eez::VALUE_TYPE_INT32);
+    eez::flow::postEvent(flowState, componentIndex, outputIndex, &postedValue, nullptr);
+#else
     eez::flow::propagateValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex, eez::Value((int)value, eez::VALUE_TYPE_INT32));
+#endif
 }
 extern "C" void flowPropagateValueUint32(void *flowState, unsigned componentIndex, unsigned outputIndex, uint32_t value) {
+#if EEZ_FLOW_DUAL_CORE
+    eez::Value postedValue(value, eez::VALUE_TYPE_UINT32);
+    eez::flow::postEvent(flowState, componentIndex, outputIndex, &postedValue, nullptr);
+#else
     eez::flow::propagateValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex, eez::Value(value, eez::VALUE_TYPE_UINT32));
+#endif
 }
 extern "C" void flowPropagateValueLVGLEvent(void *flowState, unsigned componentIndex, unsigned outputIndex, lv_event_t *event) {
+    g_eventStats.numEvents++;
     lv_event_code_t event_code = lv_event_get_code(event);
     uint32_t code = (uint32_t)event_code;
     void *currentTarget = (void *)lv_event_get_current_target(event);
@@ -7878,12 +9308,20 @@ extern "C" void flowPropagateValueLVGLEvent(void *flowState, unsigned componentI
         rotaryDiff = lv_event_get_rotary_diff(event);
     }
 #endif
-    eez::flow::propagateValue(
-        (eez::flow::FlowState *)flowState, componentIndex, outputIndex,
-        eez::Value::makeLVGLEventRef(
-            code, currentTarget, target, userData, key, gestureDir, rotaryDiff, 0xe7f23624
-        )
+#if EEZ_FLOW_DUAL_CORE
+    eez::Value postedValue = eez::Value::makeLVGLEventRef(
+        code, currentTarget, target, userData, key, gestureDir, rotaryDiff, 0xe7f23624
     );
+    eez::flow::postEvent(flowState, componentIndex, outputIndex, &postedValue, event);
+    return;
+#endif
+    eez::Value eventValue = eez::Value::makeLVGLEventRef(
+        code, currentTarget, target, userData, key, gestureDir, rotaryDiff, 0xe7f23624
+    );
+    if (!isCoalescableLvglEvent(eventValue) || !coalesceLvglEvent(flowState, componentIndex, outputIndex, eventValue)) {
+        onLvglEventDelivered(eventValue);
+        eez::flow::propagateValue((eez::flow::FlowState *)flowState, componentIndex, outputIndex, eventValue);
+    }
     g_lastLVGLEvent = *event;
     if (event->user_data) {
         g_lastLVGLEvent.user_data = &g_lastLVGLEventUserDataBuffer;
@@ -7899,6 +9337,7 @@ extern "C" void flowPropagateValueLVGLEvent(void *flowState, unsigned componentI
 #endif
 static char textValue[EEZ_LVGL_TEMP_STRING_BUFFER_SIZE];
 extern "C" const char *_evalTextProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *errorMessage, const char *file, int line) {
+    EEZ_FLOW_LOCK();
     eez::Value value;
     if (!eez::flow::evalProperty((eez::flow::FlowState *)flowState, componentIndex, propertyIndex, value, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return "";
@@ -7907,6 +9346,7 @@ extern "C" const char *_evalTextProperty(void *flowState, unsigned componentInde
     return textValue;
 }
 extern "C" int32_t _evalIntegerProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *errorMessage, const char *file, int line) {
+    EEZ_FLOW_LOCK();
     eez::Value value;
     if (!eez::flow::evalProperty((eez::flow::FlowState *)flowState, componentIndex, propertyIndex, value, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return 0;
@@ -7920,6 +9360,7 @@ extern "C" int32_t _evalIntegerProperty(void *flowState, unsigned componentIndex
     return intValue;
 }
 extern "C" uint32_t _evalUnsignedIntegerProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *errorMessage, const char *file, int line) {
+    EEZ_FLOW_LOCK();
     eez::Value value;
     if (!eez::flow::evalProperty((eez::flow::FlowState *)flowState, componentIndex, propertyIndex, value, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return 0;
@@ -7933,6 +9374,7 @@ extern "C" uint32_t _evalUnsignedIntegerProperty(void *flowState, unsigned compo
     return intValue;
 }
 extern "C" bool _evalBooleanProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *errorMessage, const char *file, int line) {
+    EEZ_FLOW_LOCK();
     eez::Value value;
     if (!eez::flow::evalProperty((eez::flow::FlowState *)flowState, componentIndex, propertyIndex, value, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return 0;
@@ -7946,6 +9388,7 @@ extern "C" bool _evalBooleanProperty(void *flowState, unsigned componentIndex, u
     return booleanValue;
 }
 const char *_evalStringArrayPropertyAndJoin(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *errorMessage, const char *separator, const char *file, int line) {
+    EEZ_FLOW_LOCK();
     eez::Value value;
     if (!eez::flow::evalProperty((eez::flow::FlowState *)flowState, componentIndex, propertyIndex, value, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return "";
@@ -7971,7 +9414,8 @@ const char *_evalStringArrayPropertyAndJoin(void *flowState, unsigned componentI
     return "";
 }
 extern "C" void _assignStringProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *value, const char *errorMessage, const char *file, int line) {
-    auto component = ((eez::flow::FlowState *)flowState)->flow->components[componentIndex];
+    EEZ_FLOW_LOCK();
+    auto component = eez::flow::getComponent((eez::flow::FlowState *)flowState, componentIndex);
     eez::Value dstValue;
     if (!eez::flow::evalAssignableExpression((eez::flow::FlowState *)flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, dstValue, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return;
@@ -7980,7 +9424,8 @@ extern "C" void _assignStringProperty(void *flowState, unsigned componentIndex,
     eez::flow::assignValue((eez::flow::FlowState *)flowState, componentIndex, dstValue, srcValue);
 }
 extern "C" void _assignIntegerProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, int32_t value, const char *errorMessage, const char *file, int line) {
-    auto component = ((eez::flow::FlowState *)flowState)->flow->components[componentIndex];
+    EEZ_FLOW_LOCK();
+    auto component = eez::flow::getComponent((eez::flow::FlowState *)flowState, componentIndex);
     eez::Value dstValue;
     if (!eez::flow::evalAssignableExpression((eez::flow::FlowState *)flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, dstValue, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return;
@@ -7989,7 +9434,8 @@ extern "C" void _assignIntegerProperty(void *flowState, unsigned componentIndex,
     eez::flow::assignValue((eez::flow::FlowState *)flowState, componentIndex, dstValue, srcValue);
 }
 extern "C" void _assignBooleanProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, bool value, const char *errorMessage, const char *file, int line) {
-    auto component = ((eez::flow::FlowState *)flowState)->flow->components[componentIndex];
+    EEZ_FLOW_LOCK();
+    auto component = eez::flow::getComponent((eez::flow::FlowState *)flowState, componentIndex);
     eez::Value dstValue;
     if (!eez::flow::evalAssignableExpression((eez::flow::FlowState *)flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, dstValue, eez::flow::FlowError::Plain(errorMessage, file, line))) {
         return;
@@ -8001,6 +9447,7 @@ extern "C" float getTimelinePosition(void *flowState) {
     return ((eez::flow::FlowState *)flowState)->timelinePosition;
 }
 void *getFlowState(void *flowState, unsigned userWidgetComponentIndexOrPageIndex) {
+    EEZ_FLOW_LOCK();
     if (!flowState) {
         return eez::flow::getPageFlowState(eez::g_mainAssets, userWidgetComponentIndexOrPageIndex);
     }
@@ -8011,30 +9458,79 @@ void *getFlowState(void *flowState, unsigned userWidgetComponentIndexOrPageIndex
     return executionState->flowState;
 }
 void deletePageFlowState(unsigned pageIndex) {
+    EEZ_FLOW_LOCK();
+    if (g_keepPageFlowStateOnDelete) {
+        return;
+    }
     eez::flow::deletePageFlowState(eez::g_mainAssets, (int16_t)pageIndex);
 }
+#ifndef EEZ_FLOW_ROLLER_OPTIONS_CACHE_SIZE
+#define EEZ_FLOW_ROLLER_OPTIONS_CACHE_SIZE 8
+#endif
+struct RollerOptionsCacheEntry {
+    lv_roller_t *roller;
+    const char *options;
+    uint32_t hash;
+    uint32_t length;
+    uint32_t optionCount;
+};
+static RollerOptionsCacheEntry g_rollerOptionsCache[EEZ_FLOW_ROLLER_OPTIONS_CACHE_SIZE];
+static uint32_t g_rollerOptionsCacheNext;
+// a deleted roller's address can be reused by a new one, so its entry must go with it
+static void onRollerOptionsCacheRollerDeleted(lv_event_t *e) {
+    lv_roller_t *roller = (lv_roller_t *)lv_event_get_current_target(e);
+    for (uint32_t i = 0; i < EEZ_FLOW_ROLLER_OPTIONS_CACHE_SIZE; i++) {
+        if (g_rollerOptionsCache[i].roller == roller) {
+            memset(&g_rollerOptionsCache[i], 0, sizeof(RollerOptionsCacheEntry));
+        }
+    }
+}
 extern "C" int compareRollerOptions(lv_roller_t *roller, const char *new_val, const char *cur_val, lv_roller_mode_t mode) {
     EEZ_UNUSED(mode);
+    uint32_t hash = 2166136261u;
+    uint32_t length = 0;
     uint32_t new_option_count = 1;
-    for (int i = 0; ; i++) {
-        if (new_val[i] == '\0') {
-            if (cur_val[i] != '\0' && cur_val[i] != '\n') {
-                return 1;
-            }
-            break;
-        }
-        if (new_val[i] != cur_val[i]) {
-            return 1;
-        }
-        if (new_val[i] == '\n') {
+    for (; new_val[length]; length++) {
+        hash = (hash ^ (uint8_t)new_val[length]) * 16777619u;
+        if (new_val[length] == '\n') {
             new_option_count++;
         }
     }
 #if LVGL_VERSION_MAJOR >= 9
-    return lv_roller_get_option_count((const lv_obj_t *)roller) == new_option_count ? 0 : 1;    
+    uint32_t option_count = lv_roller_get_option_count((const lv_obj_t *)roller);
 #else
-    return lv_roller_get_option_cnt((const lv_obj_t *)roller) == new_option_count ? 0 : 1;    
+    uint32_t option_count = lv_roller_get_option_cnt((const lv_obj_t *)roller);
 #endif
+    if (option_count != new_option_count) {
+        return 1;
+    }
+    RollerOptionsCacheEntry *entry = nullptr;
+    for (uint32_t i = 0; i < EEZ_FLOW_ROLLER_OPTIONS_CACHE_SIZE; i++) {
+        if (g_rollerOptionsCache[i].roller == roller) {
+            entry = &g_rollerOptionsCache[i];
+            break;
+        }
+    }
+    if (entry && entry->options == cur_val && entry->hash == hash && entry->length == length && entry->optionCount == option_count) {
+        return 0;
+    }
+    if (strncmp(new_val, cur_val, length) != 0 || (cur_val[length] != '\0' && cur_val[length] != '\n')) {
+        return 1;
+    }
+    if (!entry) {
+        entry = &g_rollerOptionsCache[g_rollerOptionsCacheNext];
+        g_rollerOptionsCacheNext = (g_rollerOptionsCacheNext + 1) % EEZ_FLOW_ROLLER_OPTIONS_CACHE_SIZE;
+        if (entry->roller) {
+            lv_obj_remove_event_cb((lv_obj_t *)entry->roller, onRollerOptionsCacheRollerDeleted);
+        }
+        entry->roller = roller;
+        lv_obj_add_event_cb((lv_obj_t *)roller, onRollerOptionsCacheRollerDeleted, LV_EVENT_DELETE, nullptr);
+    }
+    entry->options = cur_val;
+    entry->hash = hash;
+    entry->length = length;
+    entry->optionCount = option_count;
+    return 0;
 }
 uint32_t eez_flow_get_selected_theme_index() {
     return g_selectedThemeIndex;
@@ -9856,6 +11352,10 @@ static void do_OPERATION_TYPE_ARRAY_LENGTH(EvalStack &stack) {
         stack.push(Value(blobRef->len, VALUE_TYPE_UINT32));
         return;
     }
+    if (a.isPackedArray()) {
+        stack.push(Value(a.getPackedArray()->arraySize, VALUE_TYPE_UINT32));
+        return;
+    }
 #if defined(EEZ_DASHBOARD_API)
     if (a.isJson()) {
         int length = operationJsonArrayLength(a.getInt());
@@ -9867,6 +11367,14 @@ static void do_OPERATION_TYPE_ARRAY_LENGTH(EvalStack &stack) {
 #endif
     stack.push(Value::makeError());
 }
+static bool detachArrayElements(ArrayValue *array, uint32_t from, uint32_t to) {
+    for (uint32_t elementIndex = from; elementIndex < to && elementIndex < array->arraySize; elementIndex++) {
+        if (!detachArrayElement(array, elementIndex)) {
+            return false;
+        }
+    }
+    return true;
+}
 static void do_OPERATION_TYPE_ARRAY_SLICE(EvalStack &stack) {
     auto numArgs = stack.pop().getInt();
     auto arrayValue = stack.pop().getValue();
@@ -9914,6 +11422,27 @@ static void do_OPERATION_TYPE_ARRAY_SLICE(EvalStack &stack) {
         return;
     }
 #endif
+    if (arrayValue.isPackedArray()) {
+        auto packedArray = arrayValue.getPackedArray();
+        if (to == -1) {
+            to = packedArray->arraySize;
+        }
+        if (from > to) {
+            stack.push(Value::makeError());
+            return;
+        }
+        auto resultArrayValue = Value::makePackedArrayRef(to - from, packedArray->arrayType, 0xe2d78c65);
+        if (!resultArrayValue.isPackedArray()) {
+            stack.push(Value::makeError());
+            return;
+        }
+        if (from < (int)packedArray->arraySize) {
+            auto copyTo = to < (int)packedArray->arraySize ? to : (int)packedArray->arraySize;
+            memcpy(resultArrayValue.getPackedArray()->data, packedArray->data + from * packedArray->elementSize, (copyTo - from) * packedArray->elementSize);
+        }
+        stack.push(resultArrayValue);
+        return;
+    }
     if (!arrayValue.isArray()) {
         stack.push(Value::makeError());
         return;
@@ -9926,6 +11455,10 @@ static void do_OPERATION_TYPE_ARRAY_SLICE(EvalStack &stack) {
         stack.push(Value::makeError());
         return;
     }
+    if (!detachArrayElements(array, from, to)) {
+        stack.push(Value::makeError());
+        return;
+    }
     auto size = to - from;
     auto resultArrayValue = Value::makeArrayRef(size, array->arrayType, 0xe2d78c65);
     auto resultArray = resultArrayValue.getArray();
@@ -9949,6 +11482,90 @@ static void do_OPERATION_TYPE_ARRAY_ALLOCATE(EvalStack &stack) {
     auto resultArrayValue = Value::makeArrayRef(size, defs_v3::ARRAY_TYPE_ANY, 0xe2d78c65);
     stack.push(resultArrayValue);
 }
+static Value insertPackedArrayElement(Value &arrayValue, uint32_t position, const Value &value, uint32_t id) {
+    auto packedArray = arrayValue.getPackedArray();
+    auto elementSize = packedArray->elementSize;
+    uint8_t element[8];
+    if (!packedArray->pack(value, element)) {
+        return Value::makeError();
+    }
+    if (arrayValue.refValue->refCounter == 1 && packedArray->reserve(packedArray->arraySize + 1)) {
+        auto dst = packedArray->data + position * elementSize;
+        memmove(dst + elementSize, dst, (packedArray->arraySize - position) * elementSize);
+        memcpy(dst, element, elementSize);
+        packedArray->arraySize++;
+        return arrayValue;
+    }
+    auto resultArrayValue = Value::makePackedArrayRef(packedArray->arraySize + 1, packedArray->arrayType, id);
+    if (!resultArrayValue.isPackedArray()) {
+        return Value::makeError();
+    }
+    auto dst = resultArrayValue.getPackedArray()->data;
+    memcpy(dst, packedArray->data, position * elementSize);
+    memcpy(dst + position * elementSize, element, elementSize);
+    memcpy(dst + (position + 1) * elementSize, packedArray->data + position * elementSize, (packedArray->arraySize - position) * elementSize);
+    return resultArrayValue;
+}
+static Value removePackedArrayElement(Value &arrayValue, uint32_t position, uint32_t id) {
+    auto packedArray = arrayValue.getPackedArray();
+    auto elementSize = packedArray->elementSize;
+    if (arrayValue.refValue->refCounter == 1) {
+        auto dst = packedArray->data + position * elementSize;
+        memmove(dst, dst + elementSize, (packedArray->arraySize - position - 1) * elementSize);
+        packedArray->arraySize--;
+        return arrayValue;
+    }
+    auto resultArrayValue = Value::makePackedArrayRef(packedArray->arraySize - 1, packedArray->arrayType, id);
+    if (!resultArrayValue.isPackedArray()) {
+        return Value::makeError();
+    }
+    auto dst = resultArrayValue.getPackedArray()->data;
+    memcpy(dst, packedArray->data, position * elementSize);
+    memcpy(dst + position * elementSize, packedArray->data + (position + 1) * elementSize, (packedArray->arraySize - position - 1) * elementSize);
+    return resultArrayValue;
+}
+static bool canMutateArrayInPlace(EvalStack &stack, const Value &arrayValue) {
+    if (arrayValue.type != VALUE_TYPE_ARRAY_REF) {
+        return false;
+    }
+    if (arrayValue.refValue->refCounter == 1) {
+        return true;
+    }
+    auto target = stack.assignmentTarget;
+    return arrayValue.refValue->refCounter == 2 && target && target->type == VALUE_TYPE_ARRAY_REF && target->refValue == arrayValue.refValue;
+}
+static bool reserveArrayRef(EvalStack &stack, Value &arrayValue, uint32_t minCapacity) {
+    auto arrayRef = (ArrayValueRef *)arrayValue.refValue;
+    if (minCapacity <= arrayRef->capacity) {
+        return true;
+    }
+    uint32_t capacity = arrayRef->capacity < 4 ? 4 : 2 * arrayRef->capacity;
+    if (capacity < minCapacity) {
+        capacity = minCapacity;
+    }
+    auto ptr = alloc(sizeof(ArrayValueRef) + (capacity - 1) * sizeof(Value), 0x9a3f2e71);
+    if (ptr == nullptr) {
+        return false;
+    }
+    ArrayValueRef *newArrayRef = new (ptr) ArrayValueRef;
+    newArrayRef->refCounter = arrayRef->refCounter;
+    newArrayRef->capacity = capacity;
+    newArrayRef->cowShared = arrayRef->cowShared;
+    newArrayRef->arrayValue.arraySize = arrayRef->arrayValue.arraySize;
+    newArrayRef->arrayValue.arrayType = arrayRef->arrayValue.arrayType;
+    memcpy((void *)newArrayRef->arrayValue.values, (void *)arrayRef->arrayValue.values, arrayRef->capacity * sizeof(Value));
+    for (uint32_t i = arrayRef->capacity; i < capacity; i++) {
+        new (newArrayRef->arrayValue.values + i) Value();
+    }
+    eez::flow::onArrayValueFree(&arrayRef->arrayValue);
+    free(arrayRef);
+    auto target = stack.assignmentTarget;
+    if (target && target->type == VALUE_TYPE_ARRAY_REF && target->refValue == arrayRef) {
+        target->refValue = newArrayRef;
+    }
+    arrayValue.refValue = newArrayRef;
+    return true;
+}
 static void do_OPERATION_TYPE_ARRAY_APPEND(EvalStack &stack) {
     auto arrayValue = stack.pop().getValue();
     if (arrayValue.isError()) {
@@ -9966,11 +11583,25 @@ static void do_OPERATION_TYPE_ARRAY_APPEND(EvalStack &stack) {
         return;
     }
 #endif
+    if (arrayValue.isPackedArray()) {
+        stack.push(insertPackedArrayElement(arrayValue, arrayValue.getPackedArray()->arraySize, value, 0x664c3199));
+        return;
+    }
     if (!arrayValue.isArray()) {
         stack.push(Value::makeError());
         return;
     }
+    if (canMutateArrayInPlace(stack, arrayValue) && reserveArrayRef(stack, arrayValue, arrayValue.getArray()->arraySize + 1)) {
+        auto array = arrayValue.getArray();
+        array->values[array->arraySize++] = value;
+        stack.push(arrayValue);
+        return;
+    }
     auto array = arrayValue.getArray();
+    if (!detachArrayElements(array, 0, array->arraySize)) {
+        stack.push(Value::makeError());
+        return;
+    }
     auto resultArrayValue = Value::makeArrayRef(array->arraySize + 1, array->arrayType, 0x664c3199);
     auto resultArray = resultArrayValue.getArray();
     for (uint32_t elementIndex = 0; elementIndex < array->arraySize; elementIndex++) {
@@ -10007,18 +11638,41 @@ static void do_OPERATION_TYPE_ARRAY_INSERT(EvalStack &stack) {
         return;
     }
 #endif
+    if (arrayValue.isPackedArray()) {
+        auto arraySize = arrayValue.getPackedArray()->arraySize;
+        if (position < 0) {
+            position = 0;
+        } else if ((uint32_t)position > arraySize) {
+            position = arraySize;
+        }
+        stack.push(insertPackedArrayElement(arrayValue, position, value, 0xc4fa9cd9));
+        return;
+    }
     if (!arrayValue.isArray()) {
         stack.push(Value::makeError());
         return;
     }
     auto array = arrayValue.getArray();
-    auto resultArrayValue = Value::makeArrayRef(array->arraySize + 1, array->arrayType, 0xc4fa9cd9);
-    auto resultArray = resultArrayValue.getArray();
     if (position < 0) {
         position = 0;
     } else if ((uint32_t)position > array->arraySize) {
         position = array->arraySize;
     }
+    if (canMutateArrayInPlace(stack, arrayValue) && reserveArrayRef(stack, arrayValue, array->arraySize + 1)) {
+        array = arrayValue.getArray();
+        array->values[array->arraySize].~Value();
+        memmove((void *)(array->values + position + 1), (void *)(array->values + position), (array->arraySize - position) * sizeof(Value));
+        new (array->values + position) Value(value);
+        array->arraySize++;
+        stack.push(arrayValue);
+        return;
+    }
+    if (!detachArrayElements(array, 0, array->arraySize)) {
+        stack.push(Value::makeError());
+        return;
+    }
+    auto resultArrayValue = Value::makeArrayRef(array->arraySize + 1, array->arrayType, 0xc4fa9cd9);
+    auto resultArray = resultArrayValue.getArray();
     for (uint32_t elementIndex = 0; (int)elementIndex < position; elementIndex++) {
         resultArray->values[elementIndex] = array->values[elementIndex];
     }
@@ -10051,12 +11705,30 @@ static void do_OPERATION_TYPE_ARRAY_REMOVE(EvalStack &stack) {
         return;
     }
 #endif
+    if (arrayValue.isPackedArray()) {
+        if (position >= 0 && position < (int32_t)arrayValue.getPackedArray()->arraySize) {
+            stack.push(removePackedArrayElement(arrayValue, position, 0x40e9bb4b));
+        } else {
+            stack.push(Value::makeError());
+        }
+        return;
+    }
     if (!arrayValue.isArray()) {
         stack.push(Value::makeError());
         return;
     }
     auto array = arrayValue.getArray();
-    if (position >= 0 && position < (int32_t)array->arraySize) {
+    if (position >= 0 && position < (int32_t)array->arraySize && canMutateArrayInPlace(stack, arrayValue)) {
+        array->values[position].~Value();
+        memmove((void *)(array->values + position), (void *)(array->values + position + 1), (array->arraySize - position - 1) * sizeof(Value));
+        new (array->values + array->arraySize - 1) Value();
+        array->arraySize--;
+        stack.push(arrayValue);
+    } else if (position >= 0 && position < (int32_t)array->arraySize) {
+        if (!detachArrayElements(array, 0, array->arraySize)) {
+            stack.push(Value::makeError());
+            return;
+        }
         auto resultArrayValue = Value::makeArrayRef(array->arraySize - 1, array->arrayType, 0x40e9bb4b);
         auto resultArray = resultArrayValue.getArray();
         for (uint32_t elementIndex = 0; (int)elementIndex < position; elementIndex++) {
@@ -10381,7 +12053,6 @@ using namespace eez::gui;
 namespace eez {
 namespace flow {
 GlobalVariables *g_globalVariables = nullptr;
-static const unsigned NO_COMPONENT_INDEX = 0xFFFFFFFF;
 static bool g_enableThrowError = true;
 inline bool isInputEmpty(const Value& inputValue) {
     return inputValue.type == VALUE_TYPE_UNDEFINED && inputValue.int32Value > 0;
@@ -10399,16 +12070,354 @@ void initGlobalVariables(Assets *assets) {
     auto numVars = flowDefinition->globalVariables.count;
     g_globalVariables = (GlobalVariables *) alloc(
         sizeof(GlobalVariables) +
-        (numVars > 0 ? numVars - 1 : 0) * sizeof(Value),
+        (numVars > 0 ? numVars - 1 : 0) * sizeof(Value) +
+        numVars * sizeof(uint32_t),
         0xcc34ca8e
     );
+    g_globalVariables->count = numVars;
+    g_globalVariables->versions = (uint32_t *)(g_globalVariables->values + numVars);
     for (uint32_t i = 0; i < numVars; i++) {
 		new (g_globalVariables->values + i) Value();
         g_globalVariables->values[i] = flowDefinition->globalVariables[i]->clone();
+        g_globalVariables->versions[i] = 0;
 	}
 }
+enum ComponentReadinessKind {
+    READINESS_NEVER,
+    READINESS_ALWAYS,
+    READINESS_START,
+    READINESS_MASK,
+    READINESS_SCAN
+};
+struct ComponentReadiness {
+    uint8_t kind;
+    uint32_t requiredInputs;
+    uint32_t seqInputs;
+};
+struct FlowRuntimeInfo {
+    ComponentReadiness *componentReadiness;
+    uint16_t *inputComponentIndex;
+    uint8_t *inputPosition;
+    uint16_t *startComponents;
+    uint32_t numStartComponents;
+    uint16_t *callInputComponents;
+    uint32_t numCallInputComponents;
+    int32_t catchErrorComponentIndex;
+    uint16_t *executionStateSlotOffset;
+    uint8_t *executionStateSlotSize;
+    uint8_t *seqOutputIndex;
+    uint32_t executionStateSlotsSize;
+#if EEZ_FLOW_RESOLVED_ASSETS
+    Component **components;
+    uint32_t *firstInput;
+    uint16_t *inputs;
+    uint32_t *firstOutput;
+    uint32_t *firstConnection;
+    uint16_t *connectionTargetComponentIndex;
+    uint16_t *connectionTargetInputIndex;
+#endif
+};
+static const uint8_t NO_INPUT_POSITION = 0xFF;
+static const uint8_t NO_SEQ_OUTPUT = 0xFF;
+static FlowRuntimeInfo *g_flowRuntimeInfo;
+static FlowDefinition *g_flowRuntimeInfoFlowDefinition;
+static uint32_t g_flowRuntimeInfoMemorySize;
+static uint32_t g_resolvedAssetsMemorySize;
+#if !defined(EEZ_FLOW_INLINE_EXECUTION_STATE_MAX_SIZE)
+#define EEZ_FLOW_INLINE_EXECUTION_STATE_MAX_SIZE 64
+#endif
+static_assert(EEZ_FLOW_INLINE_EXECUTION_STATE_MAX_SIZE <= 248, "EEZ_FLOW_INLINE_EXECUTION_STATE_MAX_SIZE too big");
+static uint8_t getInlineExecutionStateSize(Component *component) {
+    size_t size = 0;
+    if (component->type == defs_v3::COMPONENT_TYPE_INPUT_ACTION) {
+        size = sizeof(InputActionComponentExecutionState);
+    } else if (component->type == defs_v3::COMPONENT_TYPE_WATCH_VARIABLE_ACTION) {
+        size = sizeof(WatchVariableComponenentExecutionState);
+    } else if (component->type == defs_v3::COMPONENT_TYPE_DELAY_ACTION) {
+        size = sizeof(DelayComponenentExecutionState);
+    } else if (component->type == defs_v3::COMPONENT_TYPE_CATCH_ERROR_ACTION) {
+        size = sizeof(CatchErrorComponenentExecutionState);
+    } else if (component->type == defs_v3::COMPONENT_TYPE_COUNTER_ACTION) {
+        size = sizeof(CounterComponenentExecutionState);
+    } else if (component->type == defs_v3::COMPONENT_TYPE_LOOP_ACTION) {
+        size = sizeof(LoopComponenentExecutionState);
+    } else if (component->type == defs_v3::COMPONENT_TYPE_ANIMATE_ACTION) {
+        size = sizeof(AnimateComponenentExecutionState);
+    }
+#if defined(EEZ_FOR_LVGL)
+    else if (component->type == defs_v3::COMPONENT_TYPE_LVGL_ACTION) {
+        size = sizeof(LVGLExecutionState);
+    }
+#endif
+    size = (size + 7) & ~7;
+    return size <= EEZ_FLOW_INLINE_EXECUTION_STATE_MAX_SIZE ? size : 0;
+}
+static uint8_t getComponentReadinessKind(Component *component) {
+	if (component->type == defs_v3::COMPONENT_TYPE_CATCH_ERROR_ACTION) {
+		return READINESS_NEVER;
+	}
+    if (component->type == defs_v3::COMPONENT_TYPE_ON_EVENT_ACTION) {
+        return READINESS_NEVER;
+    }
+    if (component->type == defs_v3::COMPONENT_TYPE_LABEL_IN_ACTION) {
+        return READINESS_NEVER;
+    }
+    if (component->type > defs_v3::FIRST_LVGL_WIDGET_COMPONENT_TYPE) {
+        return READINESS_NEVER;
+    }
+    if ((component->type < defs_v3::COMPONENT_TYPE_START_ACTION && component->type != defs_v3::COMPONENT_TYPE_USER_WIDGET_WIDGET) || component->type >= defs_v3::FIRST_DASHBOARD_WIDGET_COMPONENT_TYPE) {
+        return READINESS_ALWAYS;
+    }
+    if (component->type == defs_v3::COMPONENT_TYPE_START_ACTION) {
+        return READINESS_START;
+    }
+    return component->inputs.count <= 32 ? READINESS_MASK : READINESS_SCAN;
+}
+void initFlowRuntimeInfo(Assets *assets) {
+    freeFlowRuntimeInfo();
+    if (!g_mainAssetsUncompressed) {
+        return;
+    }
+	auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
+    auto numFlows = flowDefinition->flows.count;
+    uint32_t numComponents = 0;
+    uint32_t numInputs = 0;
+#if EEZ_FLOW_RESOLVED_ASSETS
+    uint32_t numComponentInputs = 0;
+    uint32_t numOutputs = 0;
+    uint32_t numConnections = 0;
+#endif
+    for (uint32_t flowIndex = 0; flowIndex < numFlows; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        numComponents += flow->components.count;
+        numInputs += flow->componentInputs.count;
+#if EEZ_FLOW_RESOLVED_ASSETS
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            auto component = flow->components[componentIndex];
+            numComponentInputs += component->inputs.count;
+            numOutputs += component->outputs.count;
+            for (uint32_t outputIndex = 0; outputIndex < component->outputs.count; outputIndex++) {
+                numConnections += component->outputs[outputIndex]->connections.count;
+            }
+        }
+#endif
+    }
+    uint32_t size = numFlows * sizeof(FlowRuntimeInfo) +
+        numComponents * (sizeof(ComponentReadiness) + 3 * sizeof(uint16_t) + 2 * sizeof(uint8_t)) +
+        numInputs * (sizeof(uint16_t) + sizeof(uint8_t));
+#if EEZ_FLOW_RESOLVED_ASSETS
+    uint32_t resolvedAssetsSize = numComponents * sizeof(Component *) +
+        (2 * (numComponents + numFlows) + numOutputs + numFlows) * sizeof(uint32_t) +
+        (numComponentInputs + 2 * numConnections) * sizeof(uint16_t);
+    size += resolvedAssetsSize;
+#endif
+    auto buffer = (uint8_t *)alloc(size, 0x7d2b15c3);
+    if (!buffer) {
+        return;
+    }
+    g_flowRuntimeInfo = (FlowRuntimeInfo *)buffer;
+    g_flowRuntimeInfoFlowDefinition = flowDefinition;
+    g_flowRuntimeInfoMemorySize = size;
+#if EEZ_FLOW_RESOLVED_ASSETS
+    g_resolvedAssetsMemorySize = resolvedAssetsSize;
+    auto components = (Component **)(g_flowRuntimeInfo + numFlows);
+    auto componentReadiness = (ComponentReadiness *)(components + numComponents);
+    auto firstInput = (uint32_t *)(componentReadiness + numComponents);
+    auto firstOutput = firstInput + numComponents + numFlows;
+    auto firstConnection = firstOutput + numComponents + numFlows;
+    auto startComponents = (uint16_t *)(firstConnection + numOutputs + numFlows);
+    auto inputs = startComponents + numComponents;
+    auto connectionTargetComponentIndex = inputs + numComponentInputs;
+    auto connectionTargetInputIndex = connectionTargetComponentIndex + numConnections;
+    auto executionStateSlotOffset = connectionTargetInputIndex + numConnections;
+#else
+    auto componentReadiness = (ComponentReadiness *)(g_flowRuntimeInfo + numFlows);
+    auto startComponents = (uint16_t *)(componentReadiness + numComponents);
+    auto executionStateSlotOffset = startComponents + numComponents;
+#endif
+    auto callInputComponents = executionStateSlotOffset + numComponents;
+    auto inputComponentIndex = callInputComponents + numComponents;
+    auto inputPosition = (uint8_t *)(inputComponentIndex + numInputs);
+    auto executionStateSlotSize = inputPosition + numInputs;
+    auto seqOutputIndex = executionStateSlotSize + numComponents;
+    for (uint32_t flowIndex = 0; flowIndex < numFlows; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        auto &info = g_flowRuntimeInfo[flowIndex];
+        info.componentReadiness = componentReadiness;
+        componentReadiness += flow->components.count;
+        info.inputComponentIndex = inputComponentIndex;
+        inputComponentIndex += flow->componentInputs.count;
+        info.inputPosition = inputPosition;
+        inputPosition += flow->componentInputs.count;
+        info.startComponents = startComponents;
+        info.numStartComponents = 0;
+        info.callInputComponents = callInputComponents;
+        info.numCallInputComponents = 0;
+        info.catchErrorComponentIndex = -1;
+        info.executionStateSlotOffset = executionStateSlotOffset;
+        executionStateSlotOffset += flow->components.count;
+        info.executionStateSlotSize = executionStateSlotSize;
+        executionStateSlotSize += flow->components.count;
+        info.seqOutputIndex = seqOutputIndex;
+        seqOutputIndex += flow->components.count;
+        info.executionStateSlotsSize = 0;
+        memset(info.inputComponentIndex, 0, flow->componentInputs.count * sizeof(uint16_t));
+        memset(info.inputPosition, NO_INPUT_POSITION, flow->componentInputs.count * sizeof(uint8_t));
+#if EEZ_FLOW_RESOLVED_ASSETS
+        info.components = components;
+        components += flow->components.count;
+        info.firstInput = firstInput;
+        firstInput += flow->components.count + 1;
+        info.inputs = inputs;
+        info.firstOutput = firstOutput;
+        firstOutput += flow->components.count + 1;
+        info.firstConnection = firstConnection;
+        info.connectionTargetComponentIndex = connectionTargetComponentIndex;
+        info.connectionTargetInputIndex = connectionTargetInputIndex;
+        uint32_t numFlowComponentInputs = 0;
+        uint32_t numFlowOutputs = 0;
+        uint32_t numFlowConnections = 0;
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            auto component = flow->components[componentIndex];
+            info.components[componentIndex] = component;
+            info.firstInput[componentIndex] = numFlowComponentInputs;
+            for (uint32_t inputIndex = 0; inputIndex < component->inputs.count; inputIndex++) {
+                info.inputs[numFlowComponentInputs++] = component->inputs[inputIndex];
+            }
+            info.firstOutput[componentIndex] = numFlowOutputs;
+            for (uint32_t outputIndex = 0; outputIndex < component->outputs.count; outputIndex++) {
+                auto componentOutput = component->outputs[outputIndex];
+                info.firstConnection[numFlowOutputs++] = numFlowConnections;
+                for (uint32_t connectionIndex = 0; connectionIndex < componentOutput->connections.count; connectionIndex++) {
+                    auto connection = componentOutput->connections[connectionIndex];
+                    info.connectionTargetComponentIndex[numFlowConnections] = connection->targetComponentIndex;
+                    info.connectionTargetInputIndex[numFlowConnections] = connection->targetInputIndex;
+                    numFlowConnections++;
+                }
+            }
+        }
+        info.firstInput[flow->components.count] = numFlowComponentInputs;
+        info.firstOutput[flow->components.count] = numFlowOutputs;
+        info.firstConnection[numFlowOutputs] = numFlowConnections;
+        inputs += numFlowComponentInputs;
+        firstConnection += numFlowOutputs + 1;
+        connectionTargetComponentIndex += numFlowConnections;
+        connectionTargetInputIndex += numFlowConnections;
+#endif
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            auto component = flow->components[componentIndex];
+            auto &readiness = info.componentReadiness[componentIndex];
+            readiness.kind = getComponentReadinessKind(component);
+            if (component->type == defs_v3::COMPONENT_TYPE_CATCH_ERROR_ACTION && info.catchErrorComponentIndex == -1) {
+                info.catchErrorComponentIndex = componentIndex;
+            }
+            if (component->type == defs_v3::COMPONENT_TYPE_INPUT_ACTION || component->type == defs_v3::COMPONENT_TYPE_START_ACTION) {
+                info.callInputComponents[info.numCallInputComponents++] = componentIndex;
+            }
+            info.seqOutputIndex[componentIndex] = NO_SEQ_OUTPUT;
+            for (uint32_t outputIndex = 0; outputIndex < component->outputs.count && outputIndex < NO_SEQ_OUTPUT; outputIndex++) {
+                if (component->outputs[outputIndex]->isSeqOut) {
+                    info.seqOutputIndex[componentIndex] = outputIndex;
+                    break;
+                }
+            }
+            auto slotSize = getInlineExecutionStateSize(component);
+            if (slotSize > 0 && info.executionStateSlotsSize + slotSize <= 0xFFFF) {
+                info.executionStateSlotOffset[componentIndex] = info.executionStateSlotsSize;
+                info.executionStateSlotSize[componentIndex] = slotSize;
+                info.executionStateSlotsSize += slotSize;
+            } else {
+                info.executionStateSlotOffset[componentIndex] = 0;
+                info.executionStateSlotSize[componentIndex] = 0;
+            }
+            readiness.requiredInputs = 0;
+            readiness.seqInputs = 0;
+            for (uint32_t inputIndex = 0; inputIndex < component->inputs.count && inputIndex < 32; inputIndex++) {
+                auto inputValueIndex = component->inputs[inputIndex];
+                info.inputComponentIndex[inputValueIndex] = componentIndex;
+                info.inputPosition[inputValueIndex] = inputIndex;
+                auto input = flow->componentInputs[inputValueIndex];
+                if (input & COMPONENT_INPUT_FLAG_IS_SEQ_INPUT) {
+                    readiness.seqInputs |= 1u << inputIndex;
+                } else if (!(input & COMPONENT_INPUT_FLAG_IS_OPTIONAL)) {
+                    readiness.requiredInputs |= 1u << inputIndex;
+                }
+            }
+            if (
+                readiness.kind == READINESS_ALWAYS ||
+                readiness.kind == READINESS_START ||
+                readiness.kind == READINESS_SCAN ||
+                (readiness.kind == READINESS_MASK && !readiness.requiredInputs && !readiness.seqInputs)
+            ) {
+                info.startComponents[info.numStartComponents++] = componentIndex;
+            }
+        }
+        startComponents += info.numStartComponents;
+        callInputComponents += info.numCallInputComponents;
+    }
+#if defined(EEZ_FOR_LVGL)
+    LV_LOG_INFO("EEZ-FLOW runtime tables: %u bytes, resolved assets: %u bytes", (unsigned)g_flowRuntimeInfoMemorySize, (unsigned)g_resolvedAssetsMemorySize);
+#endif
+}
+void freeFlowRuntimeInfo() {
+    if (g_flowRuntimeInfo) {
+        free(g_flowRuntimeInfo);
+        g_flowRuntimeInfo = nullptr;
+        g_flowRuntimeInfoFlowDefinition = nullptr;
+        g_flowRuntimeInfoMemorySize = 0;
+        g_resolvedAssetsMemorySize = 0;
+    }
+}
+uint32_t getFlowRuntimeInfoMemorySize() {
+    return g_flowRuntimeInfoMemorySize;
+}
+uint32_t getResolvedAssetsMemorySize() {
+    return g_resolvedAssetsMemorySize;
+}
+static inline FlowRuntimeInfo *getFlowRuntimeInfo(FlowState *flowState) {
+    if (g_flowRuntimeInfoFlowDefinition == flowState->flowDefinition) {
+        return &g_flowRuntimeInfo[flowState->flowIndex];
+    }
+    return nullptr;
+}
+const uint16_t *getCallInputComponents(FlowState *flowState, uint32_t &numComponents) {
+    auto info = getFlowRuntimeInfo(flowState);
+    if (!info) {
+        return nullptr;
+    }
+    numComponents = info->numCallInputComponents;
+    return info->callInputComponents;
+}
+static inline void updateInputFilled(FlowState *flowState, FlowRuntimeInfo *info, unsigned inputIndex) {
+    auto position = info->inputPosition[inputIndex];
+    if (position != NO_INPUT_POSITION) {
+        auto &filledInputs = flowState->componentFilledInputs[info->inputComponentIndex[inputIndex]];
+        if (isInputEmpty(flowState->values[inputIndex])) {
+            filledInputs &= ~(1u << position);
+        } else {
+            filledInputs |= 1u << position;
+        }
+    }
+}
 static bool isComponentReadyToRun(FlowState *flowState, unsigned componentIndex) {
-	auto component = flowState->flow->components[componentIndex];
+    auto info = getFlowRuntimeInfo(flowState);
+    if (info) {
+        auto &readiness = info->componentReadiness[componentIndex];
+        if (readiness.kind == READINESS_MASK) {
+            auto filledInputs = flowState->componentFilledInputs[componentIndex];
+            if ((filledInputs & readiness.requiredInputs) != readiness.requiredInputs) {
+                return false;
+            }
+            return !readiness.seqInputs || (filledInputs & readiness.seqInputs);
+        }
+        if (readiness.kind == READINESS_NEVER) {
+            return false;
+        }
+        if (readiness.kind == READINESS_ALWAYS) {
+            return true;
+        }
+    }
+	auto component = getComponent(flowState, componentIndex);
 	if (component->type == defs_v3::COMPONENT_TYPE_CATCH_ERROR_ACTION) {
 		return false;
 	}
@@ -10426,7 +12435,7 @@ static bool isComponentReadyToRun(FlowState *flowState, unsigned componentIndex)
     }
     if (component->type == defs_v3::COMPONENT_TYPE_START_ACTION) {
         if (flowState->parentComponent && flowState->parentComponentIndex != -1) {
-            auto flowInputIndex = flowState->parentComponent->inputs[0];
+            auto flowInputIndex = getComponentInputIndex(flowState->parentFlowState, flowState->parentComponentIndex, 0);
             auto value = flowState->parentFlowState->values[flowInputIndex];
             return value.getType() != VALUE_TYPE_UNDEFINED;
         } else {
@@ -10436,7 +12445,7 @@ static bool isComponentReadyToRun(FlowState *flowState, unsigned componentIndex)
 	int numSeqInputs = 0;
 	int numDefinedSeqInputs = 0;
 	for (unsigned inputIndex = 0; inputIndex < component->inputs.count; inputIndex++) {
-		auto inputValueIndex = component->inputs[inputIndex];
+		auto inputValueIndex = getComponentInputIndex(flowState, componentIndex, inputIndex);
 		auto input = flowState->flow->componentInputs[inputValueIndex];
 		if (input & COMPONENT_INPUT_FLAG_IS_SEQ_INPUT) {
 			numSeqInputs++;
@@ -10464,17 +12473,134 @@ static bool pingComponent(FlowState *flowState, unsigned componentIndex, int sou
 	}
 	return false;
 }
+#if EEZ_FLOW_STATE_POOL_SIZE > 0
+struct FlowStatePoolBlock {
+    FlowStatePoolBlock *next;
+};
+static FlowStatePoolBlock **g_flowStatePool;
+static uint32_t *g_flowStatePoolSize;
+static uint32_t g_flowStatePoolNumFlows;
+static void *allocFlowStateBlock(Assets *assets, int flowIndex, size_t size, bool &fromPool) {
+    if (assets == g_mainAssets && g_flowStatePool) {
+        auto block = g_flowStatePool[flowIndex];
+        if (block) {
+            g_flowStatePool[flowIndex] = block->next;
+            g_flowStatePoolSize[flowIndex]--;
+            fromPool = true;
+            return block;
+        }
+    }
+    fromPool = false;
+    return alloc(size, 0x4c3b6ef5);
+}
+static void freePooledFlowStateBlock(int flowIndex, FlowStatePoolBlock *block) {
+    auto flow = static_cast<FlowDefinition *>(g_mainAssets->flowDefinition)->flows[flowIndex];
+    auto values = (Value *)((FlowState *)block + 1);
+    for (uint32_t i = 0; i < flow->componentInputs.count + flow->localVariables.count; i++) {
+        values[i].~Value();
+    }
+    free(block);
+}
+static bool canPoolFlowStateBlock(Assets *assets, int flowIndex) {
+    if (assets != g_mainAssets) {
+        return false;
+    }
+    if (!g_flowStatePool) {
+        auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
+        g_flowStatePoolNumFlows = flowDefinition->flows.count;
+        g_flowStatePool = (FlowStatePoolBlock **)alloc(g_flowStatePoolNumFlows * (sizeof(FlowStatePoolBlock *) + sizeof(uint32_t)), 0x1e9c7a52);
+        if (!g_flowStatePool) {
+            return false;
+        }
+        g_flowStatePoolSize = (uint32_t *)(g_flowStatePool + g_flowStatePoolNumFlows);
+        memset(g_flowStatePool, 0, g_flowStatePoolNumFlows * (sizeof(FlowStatePoolBlock *) + sizeof(uint32_t)));
+    }
+    return g_flowStatePoolSize[flowIndex] < EEZ_FLOW_STATE_POOL_SIZE;
+}
+static void freeFlowStateBlock(int flowIndex, void *ptr, bool toPool) {
+    if (toPool) {
+        auto block = (FlowStatePoolBlock *)ptr;
+        if (g_flowStatePoolSize[flowIndex] >= EEZ_FLOW_STATE_POOL_SIZE) {
+            freePooledFlowStateBlock(flowIndex, block);
+            return;
+        }
+        block->next = g_flowStatePool[flowIndex];
+        g_flowStatePool[flowIndex] = block;
+        g_flowStatePoolSize[flowIndex]++;
+        return;
+    }
+    free(ptr);
+}
+void flowStatePoolReset() {
+    if (!g_flowStatePool) {
+        return;
+    }
+    for (uint32_t flowIndex = 0; flowIndex < g_flowStatePoolNumFlows; flowIndex++) {
+        while (g_flowStatePool[flowIndex]) {
+            auto block = g_flowStatePool[flowIndex];
+            g_flowStatePool[flowIndex] = block->next;
+            freePooledFlowStateBlock(flowIndex, block);
+        }
+    }
+    free(g_flowStatePool);
+    g_flowStatePool = nullptr;
+    g_flowStatePoolSize = nullptr;
+    g_flowStatePoolNumFlows = 0;
+}
+#else
+static void *allocFlowStateBlock(Assets *assets, int flowIndex, size_t size, bool &fromPool) {
+    EEZ_UNUSED(assets);
+    EEZ_UNUSED(flowIndex);
+    fromPool = false;
+    return alloc(size, 0x4c3b6ef5);
+}
+static bool canPoolFlowStateBlock(Assets *assets, int flowIndex) {
+    EEZ_UNUSED(assets);
+    EEZ_UNUSED(flowIndex);
+    return false;
+}
+static void freeFlowStateBlock(int flowIndex, void *ptr, bool toPool) {
+    EEZ_UNUSED(flowIndex);
+    EEZ_UNUSED(toPool);
+    free(ptr);
+}
+void flowStatePoolReset() {
+}
+#endif
+static void initFlowStateValues(FlowState *flowState) {
+    auto flow = flowState->flow;
+	Value emptyInputValue = getEmptyInputValue();
+	for (unsigned i = 0; i < flow->componentInputs.count; i++) {
+		flowState->values[i] = emptyInputValue;
+	}
+	for (unsigned i = 0; i < flow->localVariables.count; i++) {
+		auto value = flow->localVariables[i];
+		flowState->values[flow->componentInputs.count + i] = *value;
+	}
+}
 static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parentFlowState, int parentComponentIndex, const Value& inputValue) {
 	auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
 	auto flow = flowDefinition->flows[flowIndex];
 	auto nValues = flow->componentInputs.count + flow->localVariables.count;
+    auto info = assets == g_mainAssets && g_flowRuntimeInfoFlowDefinition == flowDefinition ? &g_flowRuntimeInfo[flowIndex] : nullptr;
+    size_t slotsOffset = sizeof(FlowState) +
+        nValues * sizeof(Value) +
+        flow->components.count * sizeof(ComponenentExecutionState *) +
+        flow->components.count * sizeof(uint32_t);
+    size_t slotsSize = 0;
+    if (info && info->executionStateSlotsSize > 0) {
+        slotsOffset = (slotsOffset + 7) & ~7;
+        slotsSize = info->executionStateSlotsSize;
+    }
+    bool fromPool;
 	FlowState *flowState = new (
-		alloc(
-			sizeof(FlowState) +
-			nValues * sizeof(Value) +
-			flow->components.count * sizeof(ComponenentExecutionState *) +
+		allocFlowStateBlock(
+			assets,
+			flowIndex,
+			slotsOffset +
+			slotsSize +
 			flow->components.count * sizeof(bool),
-			0x4c3b6ef5
+			fromPool
 		)
 	) FlowState;
 	flowState->flowStateIndex = (int)((uint8_t *)flowState - ALLOC_BUFFER);
@@ -10485,6 +12611,7 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
 	flowState->error = false;
     flowState->deleteOnNextTick = false;
 	flowState->refCounter = 0;
+	flowState->numActiveChildren = 0;
 	flowState->parentFlowState = parentFlowState;
     flowState->executingComponentIndex = NO_COMPONENT_INDEX;
     flowState->timelinePosition = 0;
@@ -10502,7 +12629,7 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
             parentFlowState->lastChild = flowState;
         }
 		flowState->parentComponentIndex = parentComponentIndex;
-		flowState->parentComponent = parentComponentIndex == -1 ? nullptr : parentFlowState->flow->components[parentComponentIndex];
+		flowState->parentComponent = parentComponentIndex == -1 ? nullptr : getComponent(parentFlowState, parentComponentIndex);
 	} else {
         if (g_lastFlowState) {
             g_lastFlowState->nextSibling = flowState;
@@ -10520,28 +12647,34 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
     flowState->firstChild = nullptr;
     flowState->lastChild = nullptr;
     flowState->nextSibling = nullptr;
+#if EEZ_FLOW_RESOLVED_ASSETS
+    flowState->resolvedComponents = info ? info->components : nullptr;
+    flowState->resolvedFirstInput = info ? info->firstInput : nullptr;
+    flowState->resolvedInputs = info ? info->inputs : nullptr;
+#endif
 	flowState->values = (Value *)(flowState + 1);
 	flowState->componenentExecutionStates = (ComponenentExecutionState **)(flowState->values + nValues);
-    flowState->componenentAsyncStates = (bool *)(flowState->componenentExecutionStates + flow->components.count);
-	for (unsigned i = 0; i < nValues; i++) {
-		new (flowState->values + i) Value();
-	}
-	Value emptyInputValue = getEmptyInputValue();
-	for (unsigned i = 0; i < flow->componentInputs.count; i++) {
-		flowState->values[i] = emptyInputValue;
-	}
-	for (unsigned i = 0; i < flow->localVariables.count; i++) {
-		auto value = flow->localVariables[i];
-		flowState->values[flow->componentInputs.count + i] = *value;
-	}
-	for (unsigned i = 0; i < flow->components.count; i++) {
-		flowState->componenentExecutionStates[i] = nullptr;
-		flowState->componenentAsyncStates[i] = false;
-	}
+    flowState->componentFilledInputs = (uint32_t *)(flowState->componenentExecutionStates + flow->components.count);
+    flowState->componentExecutionStateSlots = slotsSize > 0 ? (uint8_t *)flowState + slotsOffset : nullptr;
+    flowState->componenentAsyncStates = (bool *)((uint8_t *)flowState + slotsOffset + slotsSize);
+    if (!fromPool) {
+	    for (unsigned i = 0; i < nValues; i++) {
+		    new (flowState->values + i) Value();
+	    }
+        initFlowStateValues(flowState);
+        memset(flowState->componenentExecutionStates, 0, flow->components.count * (sizeof(ComponenentExecutionState *) + sizeof(uint32_t)));
+        memset(flowState->componenentAsyncStates, 0, flow->components.count * sizeof(bool));
+    }
 	onFlowStateCreated(flowState);
-	for (unsigned componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
-		pingComponent(flowState, componentIndex);
-	}
+    if (info) {
+        for (uint32_t i = 0; i < info->numStartComponents; i++) {
+            pingComponent(flowState, info->startComponents[i]);
+        }
+    } else {
+	    for (unsigned componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+		    pingComponent(flowState, componentIndex);
+	    }
+    }
 	return flowState;
 }
 FlowState *initActionFlowState(int flowIndex, FlowState *parentFlowState, int parentComponentIndex, const Value &inputValue) {
@@ -10558,29 +12691,41 @@ FlowState *initPageFlowState(Assets *assets, int flowIndex, FlowState *parentFlo
 	}
 	return flowState;
 }
+static void incActiveChildren(FlowState *parent) {
+    for (; parent; parent = parent->parentFlowState) {
+        if (parent->numActiveChildren++ > 0 || parent->refCounter > 0) {
+            break;
+        }
+    }
+}
+static void decActiveChildren(FlowState *parent) {
+    for (; parent; parent = parent->parentFlowState) {
+        if (--parent->numActiveChildren > 0 || parent->refCounter > 0) {
+            break;
+        }
+    }
+}
 void incRefCounterForFlowState(FlowState *flowState) {
     if (!flowState) {
         return;
     }
-    flowState->refCounter++;
-    for (auto parent = flowState->parentFlowState; parent; parent = parent->parentFlowState) {
-        parent->refCounter++;
+    if (flowState->refCounter++ == 0 && flowState->numActiveChildren == 0) {
+        incActiveChildren(flowState->parentFlowState);
     }
 }
 void decRefCounterForFlowState(FlowState *flowState) {
     if (!flowState) {
         return;
     }
-    flowState->refCounter--;
-    for (auto parent = flowState->parentFlowState; parent; parent = parent->parentFlowState) {
-        parent->refCounter--;
+    if (--flowState->refCounter == 0 && flowState->numActiveChildren == 0) {
+        decActiveChildren(flowState->parentFlowState);
     }
 }
 bool canFreeFlowState(FlowState *flowState) {
     if (!flowState->isAction) {
         return false;
     }
-    if (flowState->refCounter > 0) {
+    if (flowState->refCounter > 0 || flowState->numActiveChildren > 0) {
         return false;
     }
     return true;
@@ -10616,19 +12761,38 @@ void freeFlowState(FlowState *flowState) {
         flowState->nextSibling->previousSibling = flowState->previousSibling;
     }
 	auto flow = flowState->flow;
-	auto valuesCount = flow->componentInputs.count + flow->localVariables.count;
-	for (unsigned int i = 0; i < valuesCount; i++) {
-		(flowState->values + i)->~Value();
-	}
+    auto toPool = canPoolFlowStateBlock(flowState->assets, flowState->flowIndex);
+    if (toPool) {
+        initFlowStateValues(flowState);
+    } else {
+	    auto valuesCount = flow->componentInputs.count + flow->localVariables.count;
+	    for (unsigned int i = 0; i < valuesCount; i++) {
+		    (flowState->values + i)->~Value();
+	    }
+    }
 	for (unsigned i = 0; i < flow->components.count; i++) {
         deallocateComponentExecutionState(flowState, i);
 	}
+    if (toPool) {
+        memset(flowState->componentFilledInputs, 0, flow->components.count * sizeof(uint32_t));
+        memset(flowState->componenentAsyncStates, 0, flow->components.count * sizeof(bool));
+    }
     removeTasksFromQueueForFlowState(flowState);
+#if EEZ_FLOW_DUAL_CORE
+    removePostedForFlowState(flowState);
+#endif
     removeWatchesForFlowState(flowState);
+#if defined(EEZ_FOR_LVGL)
+    removeLvglWaitsForFlowState(flowState);
+#endif
     freeAllChildrenFlowStates(flowState->firstChild);
+    if (flowState->refCounter > 0 || flowState->numActiveChildren > 0) {
+        decActiveChildren(parentFlowState);
+    }
 	onFlowStateDestroyed(flowState);
+    auto flowIndex = flowState->flowIndex;
 	flowState->~FlowState();
-	free(flowState);
+	freeFlowStateBlock(flowIndex, flowState, toPool);
 }
 void freeAllChildrenFlowStates(FlowState *firstChildFlowState) {
     auto flowState = firstChildFlowState;
@@ -10642,22 +12806,55 @@ void freeAllChildrenFlowStates(FlowState *firstChildFlowState) {
 void deallocateComponentExecutionState(FlowState *flowState, unsigned componentIndex) {
     auto executionState = flowState->componenentExecutionStates[componentIndex];
     if (executionState) {
-        auto component = flowState->flow->components[componentIndex];
+        auto component = getComponent(flowState, componentIndex);
         if (TRACK_REF_COUNTER_FOR_COMPONENT_STATE(component)) {
             decRefCounterForFlowState(flowState);
         }
         flowState->componenentExecutionStates[componentIndex] = nullptr;
         onComponentExecutionStateChanged(flowState, componentIndex);
-        ObjectAllocator<ComponenentExecutionState>::deallocate(executionState);
+        executionState->~ComponenentExecutionState();
+        auto slots = flowState->componentExecutionStateSlots;
+        if (!slots || (uint8_t *)executionState < slots || (uint8_t *)executionState >= (uint8_t *)flowState->componenentAsyncStates) {
+            free(executionState);
+        }
     }
 }
+void *allocComponentExecutionStateMemory(FlowState *flowState, unsigned componentIndex, size_t size) {
+    if (flowState->componentExecutionStateSlots) {
+        auto info = getFlowRuntimeInfo(flowState);
+        if (info && size <= info->executionStateSlotSize[componentIndex]) {
+            return flowState->componentExecutionStateSlots + info->executionStateSlotOffset[componentIndex];
+        }
+    }
+    return alloc(size, 0x72dc3bf4);
+}
 void resetSequenceInputs(FlowState *flowState) {
     if (flowState->executingComponentIndex != NO_COMPONENT_INDEX) {
-		auto component = flowState->flow->components[flowState->executingComponentIndex];
+        auto componentIndex = flowState->executingComponentIndex;
+		auto component = getComponent(flowState, componentIndex);
         flowState->executingComponentIndex = NO_COMPONENT_INDEX;
         if (component->type != defs_v3::COMPONENT_TYPE_OUTPUT_ACTION) {
+            auto info = getFlowRuntimeInfo(flowState);
+            if (info && info->componentReadiness[componentIndex].kind == READINESS_MASK) {
+                auto seqInputs = flowState->componentFilledInputs[componentIndex] & info->componentReadiness[componentIndex].seqInputs;
+                if (!seqInputs) {
+                    return;
+                }
+                flowState->componentFilledInputs[componentIndex] &= ~seqInputs;
+#if EEZ_FLOW_RESOLVED_ASSETS
+                auto inputs = info->inputs + info->firstInput[componentIndex];
+                for (uint32_t i = 0; seqInputs; i++, seqInputs >>= 1) {
+                    if (seqInputs & 1) {
+                        auto pValue = &flowState->values[inputs[i]];
+                        *pValue = getEmptyInputValue();
+                        onValueChanged(pValue);
+                    }
+                }
+                return;
+#endif
+            }
             for (uint32_t i = 0; i < component->inputs.count; i++) {
-                auto inputIndex = component->inputs[i];
+                auto inputIndex = getComponentInputIndex(flowState, componentIndex, i);
                 if (flowState->flow->componentInputs[inputIndex] & COMPONENT_INPUT_FLAG_IS_SEQ_INPUT) {
                     auto pValue = &flowState->values[inputIndex];
                     if (!isInputEmpty(*pValue)) {
@@ -10676,9 +12873,27 @@ void propagateValue(FlowState *flowState, unsigned componentIndex, unsigned outp
         return;
     }
     resetSequenceInputs(flowState);
-	auto component = flowState->flow->components[componentIndex];
-	auto componentOutput = component->outputs[outputIndex];
     auto value2 = value.getValue();
+    auto info = getFlowRuntimeInfo(flowState);
+#if EEZ_FLOW_RESOLVED_ASSETS
+    if (info) {
+        auto flowOutputIndex = info->firstOutput[componentIndex] + outputIndex;
+        auto lastConnectionIndex = info->firstConnection[flowOutputIndex + 1];
+        for (auto connectionIndex = info->firstConnection[flowOutputIndex]; connectionIndex < lastConnectionIndex; connectionIndex++) {
+            auto targetInputIndex = info->connectionTargetInputIndex[connectionIndex];
+            auto pValue = &flowState->values[targetInputIndex];
+            if (*pValue != value2) {
+                *pValue = value2;
+                onValueChanged(pValue);
+            }
+            updateInputFilled(flowState, info, targetInputIndex);
+            pingComponent(flowState, info->connectionTargetComponentIndex[connectionIndex], componentIndex, outputIndex, targetInputIndex);
+        }
+        return;
+    }
+#endif
+	auto component = getComponent(flowState, componentIndex);
+	auto componentOutput = component->outputs[outputIndex];
 	for (unsigned connectionIndex = 0; connectionIndex < componentOutput->connections.count; connectionIndex++) {
 		auto connection = componentOutput->connections[connectionIndex];
 		auto pValue = &flowState->values[connection->targetInputIndex];
@@ -10686,15 +12901,45 @@ void propagateValue(FlowState *flowState, unsigned componentIndex, unsigned outp
 			*pValue = value2;
 				onValueChanged(pValue);
 		}
+        if (info) {
+            updateInputFilled(flowState, info, connection->targetInputIndex);
+        }
 		pingComponent(flowState, connection->targetComponentIndex, componentIndex, outputIndex, connection->targetInputIndex);
 	}
 }
+bool replaceQueuedValue(FlowState *flowState, unsigned componentIndex, unsigned outputIndex, const Value &queuedValue, const Value &value) {
+    auto componentOutput = getComponent(flowState, componentIndex)->outputs[outputIndex];
+    if (componentOutput->connections.count == 0) {
+        return false;
+    }
+    for (unsigned connectionIndex = 0; connectionIndex < componentOutput->connections.count; connectionIndex++) {
+        auto connection = componentOutput->connections[connectionIndex];
+        auto &inputValue = flowState->values[connection->targetInputIndex];
+        if (inputValue.type != queuedValue.type || inputValue.refValue != queuedValue.refValue || !isInQueue(flowState, connection->targetComponentIndex)) {
+            return false;
+        }
+    }
+    for (unsigned connectionIndex = 0; connectionIndex < componentOutput->connections.count; connectionIndex++) {
+        auto pValue = &flowState->values[componentOutput->connections[connectionIndex]->targetInputIndex];
+        *pValue = value;
+        onValueChanged(pValue);
+    }
+    return true;
+}
 void propagateValue(FlowState *flowState, unsigned componentIndex, unsigned outputIndex) {
 	auto &nullValue = *flowState->flowDefinition->constants[NULL_VALUE_INDEX];
 	propagateValue(flowState, componentIndex, outputIndex, nullValue);
 }
 void propagateValueThroughSeqout(FlowState *flowState, unsigned componentIndex) {
-	auto component = flowState->flow->components[componentIndex];
+    auto info = getFlowRuntimeInfo(flowState);
+    if (info) {
+        auto outputIndex = info->seqOutputIndex[componentIndex];
+        if (outputIndex != NO_SEQ_OUTPUT) {
+            propagateValue(flowState, componentIndex, outputIndex);
+            return;
+        }
+    }
+	auto component = getComponent(flowState, componentIndex);
 	for (uint32_t i = 0; i < component->outputs.count; i++) {
 		if (component->outputs[i]->isSeqOut) {
 			propagateValue(flowState, componentIndex, i);
@@ -10738,6 +12983,7 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
 #else
 		setVar(dstValue.getInt(), srcValue);
 #endif
+        onNativeVariableAssigned();
 	} else {
 		Value *pDstValue;
         uint32_t dstValueType = VALUE_TYPE_UNDEFINED;
@@ -10759,6 +13005,19 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
                     throwError(flowState, componentIndex, FlowError::Plain(errorMessage));
                 } else {
                     blobRef->blob[arrayElementValue->elementIndex] = elementValue;
+                    onArrayElementAssigned();
+                }
+                return;
+            } else if (arrayElementValue->arrayValue.isPackedArray()) {
+                auto packedArray = arrayElementValue->arrayValue.getPackedArray();
+                if (arrayElementValue->elementIndex < 0 || arrayElementValue->elementIndex >= (int)packedArray->arraySize) {
+                    throwError(flowState, componentIndex, FlowError::Plain("Can not assign, array element index out of bounds"));
+                    return;
+                }
+                if (!packedArray->set(arrayElementValue->elementIndex, srcValue)) {
+                    throwError(flowState, componentIndex, FlowError::Plain("Can not assign non-numeric value to numeric array"));
+                } else {
+                    onArrayElementAssigned();
                 }
                 return;
             } else {
@@ -10768,6 +13027,7 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
                     return;
                 }
                 pDstValue = &array->values[arrayElementValue->elementIndex];
+                onArrayElementAssigned();
             }
         }
 #if defined(EEZ_DASHBOARD_API)
@@ -10816,6 +13076,7 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
             }
         }
         if (assignValue(*pDstValue, srcValue, dstValueType)) {
+            onVariableAssigned(pDstValue);
             onValueChanged(pDstValue);
         } else {
             char errorMessage[100];
@@ -10829,6 +13090,10 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
 void clearInputValue(FlowState *flowState, int inputIndex) {
     flowState->values[inputIndex] = Value();
     onValueChanged(flowState->values + inputIndex);
+    auto info = getFlowRuntimeInfo(flowState);
+    if (info) {
+        updateInputFilled(flowState, info, inputIndex);
+    }
 }
 void startAsyncExecution(FlowState *flowState, int componentIndex) {
     if (!flowState->componenentAsyncStates[componentIndex]) {
@@ -10857,7 +13122,7 @@ void endAsyncExecution(FlowState *flowState, int componentIndex) {
 }
 void onEvent(FlowState *flowState, FlowEvent flowEvent, Value eventValue) {
 	for (unsigned componentIndex = 0; componentIndex < flowState->flow->components.count; componentIndex++) {
-		auto component = flowState->flow->components[componentIndex];
+		auto component = getComponent(flowState, componentIndex);
 		if (component->type == defs_v3::COMPONENT_TYPE_ON_EVENT_ACTION) {
             auto onEventComponent = (OnEventComponent *)component;
             if (onEventComponent->event == flowEvent) {
@@ -10876,41 +13141,79 @@ void onEvent(FlowState *flowState, FlowEvent flowEvent, Value eventValue) {
         }
     }
 }
-static bool findCatchErrorComponent(FlowState *flowState, FlowState *&catchErrorFlowState, int &catchErrorComponentIndex) {
-    if (!flowState) {
-        return false;
+static int findCatchErrorComponentInFlow(FlowState *flowState) {
+    auto info = getFlowRuntimeInfo(flowState);
+    if (info) {
+        return info->catchErrorComponentIndex;
     }
 	for (unsigned componentIndex = 0; componentIndex < flowState->flow->components.count; componentIndex++) {
-		auto component = flowState->flow->components[componentIndex];
+		auto component = getComponent(flowState, componentIndex);
 		if (component->type == defs_v3::COMPONENT_TYPE_CATCH_ERROR_ACTION) {
+			return componentIndex;
+		}
+	}
+    return -1;
+}
+static bool findCatchErrorComponent(FlowState *flowState, FlowState *&catchErrorFlowState, int &catchErrorComponentIndex) {
+    for (; flowState; flowState = flowState->parentFlowState) {
+        auto componentIndex = findCatchErrorComponentInFlow(flowState);
+        if (componentIndex != -1) {
 			catchErrorFlowState = flowState;
 			catchErrorComponentIndex = componentIndex;
 			return true;
-		}
-	}
-    if (flowState->parentFlowState && flowState->parentComponent && flowState->parentComponent->errorCatchOutput != -1) {
-        catchErrorFlowState = flowState->parentFlowState;
-        catchErrorComponentIndex = flowState->parentComponentIndex;
-        return true;
+        }
+        if (flowState->parentFlowState && flowState->parentComponent && flowState->parentComponent->errorCatchOutput != -1) {
+            catchErrorFlowState = flowState->parentFlowState;
+            catchErrorComponentIndex = flowState->parentComponentIndex;
+            return true;
+        }
     }
-    return findCatchErrorComponent(flowState->parentFlowState, catchErrorFlowState, catchErrorComponentIndex);
+    return false;
 }
-void throwError(FlowState *flowState, int componentIndex, const char *errorMessage) {
-    auto component = flowState->flow->components[componentIndex];
-    if (!g_enableThrowError) {
-        return;
-    }
+struct ErrorMessage {
+    ErrorMessage(const char *message_) : message(message_), error(nullptr) {}
+    ErrorMessage(const FlowError &error_, int flowIndex_, int componentIndex_) : message(nullptr), error(&error_), flowIndex(flowIndex_), componentIndex(componentIndex_) {}
+    const char *get() {
+        if (!message) {
+            message = error->getMessage(buffer, sizeof(buffer), flowIndex, componentIndex);
+        }
+        return message;
+    }
+    Value makeValue(uint32_t id) {
+        auto str = get();
+        return Value::makeStringRef(str, strlen(str), id);
+    }
+private:
+    const char *message;
+    const FlowError *error;
+    int flowIndex;
+    int componentIndex;
+    char buffer[512];
+};
+#ifndef EEZ_FLOW_LOG_HANDLED_ERRORS
+#define EEZ_FLOW_LOG_HANDLED_ERRORS 1
+#endif
+static void logError(ErrorMessage &errorMessage) {
 #if defined(EEZ_FOR_LVGL)
-    LV_LOG_ERROR("EEZ-FLOW error: %s", errorMessage);
+    EEZ_UNUSED(errorMessage);
+    LV_LOG_ERROR("EEZ-FLOW error: %s", errorMessage.get());
 #elif defined(__EMSCRIPTEN__)
-    printf("throwError: %s\n", errorMessage);
+    printf("throwError: %s\n", errorMessage.get());
+#else
+    EEZ_UNUSED(errorMessage);
+#endif
+}
+static void throwError(FlowState *flowState, int componentIndex, ErrorMessage &errorMessage) {
+    auto component = getComponent(flowState, componentIndex);
+#if EEZ_FLOW_LOG_HANDLED_ERRORS
+    logError(errorMessage);
 #endif
 	if (component->errorCatchOutput != -1) {
 		propagateValue(
 			flowState,
 			componentIndex,
 			component->errorCatchOutput,
-			Value::makeStringRef(errorMessage, strlen(errorMessage), 0xef6f8414)
+			errorMessage.makeValue(0xef6f8414)
 		);
 	} else {
 		FlowState *catchErrorFlowState;
@@ -10925,14 +13228,20 @@ void throwError(FlowState *flowState, int componentIndex, const char *errorMessa
             for (FlowState *fs = flowState; fs != catchErrorFlowState; fs = fs->parentFlowState) {
                 if (fs->isAction) {
                     fs->error = true;
+#if defined(EEZ_FOR_LVGL)
+                    onLvglFlowStateError(fs);
+#endif
                 }
             }
-            auto component = catchErrorFlowState->flow->components[catchErrorComponentIndex];
+            auto component = getComponent(catchErrorFlowState, catchErrorComponentIndex);
             if (component->type == defs_v3::COMPONENT_TYPE_CATCH_ERROR_ACTION) {
                 auto catchErrorComponentExecutionState = allocateComponentExecutionState<CatchErrorComponenentExecutionState>(catchErrorFlowState, catchErrorComponentIndex);
-                catchErrorComponentExecutionState->message = Value::makeStringRef(errorMessage, strlen(errorMessage), 0x9473eef2);
+                catchErrorComponentExecutionState->message = errorMessage.makeValue(0x9473eef2);
                 if (!addToQueue(catchErrorFlowState, catchErrorComponentIndex, -1, -1, -1, false)) {
-                    onFlowError(flowState, componentIndex, errorMessage);
+#if !EEZ_FLOW_LOG_HANDLED_ERRORS
+                    logError(errorMessage);
+#endif
+                    onFlowError(flowState, componentIndex, errorMessage.get());
                     stopScriptHook();
                 }
             } else {
@@ -10940,15 +13249,25 @@ void throwError(FlowState *flowState, int componentIndex, const char *errorMessa
                     catchErrorFlowState,
                     catchErrorComponentIndex,
                     component->errorCatchOutput,
-                    Value::makeStringRef(errorMessage, strlen(errorMessage), 0x9473eef3)
+                    errorMessage.makeValue(0x9473eef3)
                 );
             }
 		} else {
-			onFlowError(flowState, componentIndex, errorMessage);
+#if !EEZ_FLOW_LOG_HANDLED_ERRORS
+            logError(errorMessage);
+#endif
+			onFlowError(flowState, componentIndex, errorMessage.get());
 			stopScriptHook();
 		}
 	}
 }
+void throwError(FlowState *flowState, int componentIndex, const char *errorMessage) {
+    if (!g_enableThrowError) {
+        return;
+    }
+    ErrorMessage message(errorMessage);
+    throwError(flowState, componentIndex, message);
+}
 const char *FlowError::getMessage(char *messageStr, size_t messageStrLength, int flowIndex, int componentIndex) const {
     #define GET_MESSAGE(FMT, ...) \
         if (file) snprintf(messageStr, messageStrLength, FMT " | %d.%d | %s:%d", __VA_ARGS__, flowIndex, componentIndex, file, line); \
@@ -11043,9 +13362,11 @@ const char *FlowError::getMessage(char *messageStr, size_t messageStrLength, int
     return messageStr;
 }
 void throwError(FlowState *flowState, int componentIndex, const FlowError &error) {
-    char errorMessageStr[512];
-    const char *errorMessage = error.getMessage(errorMessageStr, sizeof(errorMessageStr), flowState->flowIndex, componentIndex);
-    throwError(flowState, componentIndex, errorMessage);
+    if (!g_enableThrowError) {
+        return;
+    }
+    ErrorMessage message(error, flowState->flowIndex, componentIndex);
+    throwError(flowState, componentIndex, message);
 }
 void enableThrowError(bool enable) {
     g_enableThrowError = enable;
@@ -11071,12 +13392,20 @@ static unsigned g_queueTail;
 static unsigned g_queueMax;
 static bool g_queueIsFull = false;
 unsigned g_numNonContinuousTaskInQueue;
+#if EEZ_FLOW_LOOP_FUSION
+static FlowState *g_fusedFlowState;
+static unsigned g_fusedComponentIndex = NO_COMPONENT_INDEX;
+#endif
 void queueReset() {
 	g_queueHead = 0;
 	g_queueTail = 0;
 	g_queueMax  = 0;
 	g_queueIsFull = false;
     g_numNonContinuousTaskInQueue = 0;
+#if EEZ_FLOW_LOOP_FUSION
+    g_fusedFlowState = nullptr;
+    g_fusedComponentIndex = NO_COMPONENT_INDEX;
+#endif
 }
 size_t getQueueSize() {
 	if (g_queueHead == g_queueTail) {
@@ -11094,6 +13423,15 @@ size_t getMaxQueueSize() {
 	return g_queueMax;
 }
 bool addToQueue(FlowState *flowState, unsigned componentIndex, int sourceComponentIndex, int sourceOutputIndex, int targetInputIndex, bool continuousTask) {
+#if EEZ_FLOW_LOOP_FUSION
+    if (g_fusedFlowState) {
+        if (flowState == g_fusedFlowState && !continuousTask && g_fusedComponentIndex == NO_COMPONENT_INDEX) {
+            g_fusedComponentIndex = componentIndex;
+            return true;
+        }
+        endFusedTasks();
+    }
+#endif
 	if (g_queueIsFull) {
         throwError(flowState, componentIndex, "Execution queue is full\n");
 		return false;
@@ -11101,7 +13439,9 @@ bool addToQueue(FlowState *flowState, unsigned componentIndex, int sourceCompone
 	g_queue[g_queueTail].flowState = flowState;
 	g_queue[g_queueTail].componentIndex = componentIndex;
     g_queue[g_queueTail].continuousTask = continuousTask;
-	g_queueTail = (g_queueTail + 1) % QUEUE_SIZE;
+	if (++g_queueTail == QUEUE_SIZE) {
+        g_queueTail = 0;
+    }
 	if (g_queueHead == g_queueTail) {
 		g_queueIsFull = true;
 	}
@@ -11127,7 +13467,9 @@ void removeNextTaskFromQueue() {
 	auto flowState = g_queue[g_queueHead].flowState;
     decRefCounterForFlowState(flowState);
     auto continuousTask = g_queue[g_queueHead].continuousTask;
-	g_queueHead = (g_queueHead + 1) % QUEUE_SIZE;
+	if (++g_queueHead == QUEUE_SIZE) {
+        g_queueHead = 0;
+    }
 	g_queueIsFull = false;
     if (!continuousTask) {
         --g_numNonContinuousTaskInQueue;
@@ -11135,6 +13477,11 @@ void removeNextTaskFromQueue() {
     }
 }
 bool isInQueue(FlowState *flowState, unsigned componentIndex) {
+#if EEZ_FLOW_LOOP_FUSION
+    if (flowState == g_fusedFlowState && componentIndex == g_fusedComponentIndex) {
+        return true;
+    }
+#endif
 	if (g_queueHead == g_queueTail && !g_queueIsFull) {
 		return false;
 	}
@@ -11151,6 +13498,12 @@ bool isInQueue(FlowState *flowState, unsigned componentIndex) {
     return false;
 }
 void removeTasksFromQueueForFlowState(FlowState *flowState) {
+#if EEZ_FLOW_LOOP_FUSION
+    if (flowState == g_fusedFlowState) {
+        g_fusedFlowState = nullptr;
+        g_fusedComponentIndex = NO_COMPONENT_INDEX;
+    }
+#endif
 	if (g_queueHead == g_queueTail && !g_queueIsFull) {
 		return;
 	}
@@ -11165,6 +13518,29 @@ void removeTasksFromQueueForFlowState(FlowState *flowState) {
         }
 	}
 }
+#if EEZ_FLOW_LOOP_FUSION
+void beginFusedTasks(FlowState *flowState) {
+    g_fusedFlowState = flowState;
+    g_fusedComponentIndex = NO_COMPONENT_INDEX;
+}
+bool takeFusedTask(FlowState *flowState, unsigned &componentIndex) {
+    if (flowState != g_fusedFlowState || g_fusedComponentIndex == NO_COMPONENT_INDEX) {
+        return false;
+    }
+    componentIndex = g_fusedComponentIndex;
+    g_fusedComponentIndex = NO_COMPONENT_INDEX;
+    return true;
+}
+void endFusedTasks() {
+    auto flowState = g_fusedFlowState;
+    auto componentIndex = g_fusedComponentIndex;
+    g_fusedFlowState = nullptr;
+    g_fusedComponentIndex = NO_COMPONENT_INDEX;
+    if (flowState && componentIndex != NO_COMPONENT_INDEX) {
+        addToQueue(flowState, componentIndex, -1, -1, -1, false);
+    }
+}
+#endif
 } 
 } 
 // -----------------------------------------------------------------------------
@@ -11173,9 +13549,16 @@ void removeTasksFromQueueForFlowState(FlowState *flowState) {
 namespace eez {
 namespace flow {
 void executeWatchVariableComponent(FlowState *flowState, unsigned componentIndex);
+static const unsigned WATCH_MAX_GLOBAL_VARIABLES = 8;
 struct WatchListNode {
     FlowState *flowState;
     unsigned componentIndex;
+    bool polled;
+    bool readsLocalVariables;
+    bool readsNativeVariables;
+    uint8_t numGlobalVariables;
+    uint16_t globalVariables[WATCH_MAX_GLOBAL_VARIABLES];
+    uint32_t version;
     WatchListNode *prev;
     WatchListNode *next;
 };
@@ -11185,6 +13568,108 @@ struct WatchList {
     unsigned       size;
 };
 static WatchList g_watchList;
+static uint32_t g_localVariablesVersion;
+static uint32_t g_arrayElementsVersion;
+static uint32_t g_nativeVariablesVersion;
+void onVariableAssigned(const Value *pValue) {
+    if (g_globalVariables && pValue >= g_globalVariables->values && pValue < g_globalVariables->values + g_globalVariables->count) {
+        g_globalVariables->versions[pValue - g_globalVariables->values]++;
+    } else {
+        g_localVariablesVersion++;
+    }
+}
+void onArrayElementAssigned() {
+    g_arrayElementsVersion++;
+}
+void onNativeVariableAssigned() {
+    g_nativeVariablesVersion++;
+}
+static bool isPureOperation(uint16_t operation) {
+    switch (operation) {
+    case defs_v3::OPERATION_TYPE_SYSTEM_GET_TICK:
+    case defs_v3::OPERATION_TYPE_FLOW_INDEX:
+    case defs_v3::OPERATION_TYPE_FLOW_IS_PAGE_ACTIVE:
+    case defs_v3::OPERATION_TYPE_FLOW_PAGE_TIMELINE_POSITION:
+    case defs_v3::OPERATION_TYPE_FLOW_LANGUAGES:
+    case defs_v3::OPERATION_TYPE_FLOW_TRANSLATE:
+    case defs_v3::OPERATION_TYPE_FLOW_THEMES:
+    case defs_v3::OPERATION_TYPE_FLOW_GET_BITMAP_INDEX:
+    case defs_v3::OPERATION_TYPE_FLOW_GET_BITMAP_AS_DATA_URL:
+    case defs_v3::OPERATION_TYPE_DATE_NOW:
+    case defs_v3::OPERATION_TYPE_JSON_GET:
+    case defs_v3::OPERATION_TYPE_LVGL_METER_TICK_INDEX:
+        return false;
+    default:
+        return true;
+    }
+}
+static bool isIndirectValue(const Value &value) {
+    return value.type == VALUE_TYPE_VALUE_PTR || value.type == VALUE_TYPE_PROPERTY_REF || value.type == VALUE_TYPE_NATIVE_VARIABLE;
+}
+static bool analyzeWatchExpression(WatchListNode *node) {
+    auto flowState = node->flowState;
+    auto component = getComponent(flowState, node->componentIndex);
+    if (defs_v3::WATCH_VARIABLE_ACTION_COMPONENT_PROPERTY_VARIABLE >= component->properties.count) {
+        return false;
+    }
+    auto instructions = component->properties[defs_v3::WATCH_VARIABLE_ACTION_COMPONENT_PROPERTY_VARIABLE]->evalInstructions;
+    auto numGlobalVariables = flowState->flowDefinition->globalVariables.count;
+    for (int i = 0; ; i += 2) {
+        uint16_t instruction = instructions[i] + (instructions[i + 1] << 8);
+        auto instructionType = instruction & EXPR_EVAL_INSTRUCTION_TYPE_MASK;
+        auto instructionArg = instruction & EXPR_EVAL_INSTRUCTION_PARAM_MASK;
+        if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT || instructionType == EXPR_EVAL_INSTRUCTION_ARRAY_ELEMENT) {
+            continue;
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR) {
+            if (isIndirectValue(flowState->values[flowState->flow->componentInputs.count + instructionArg])) {
+                return false;
+            }
+            node->readsLocalVariables = true;
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR) {
+            if ((uint32_t)instructionArg < numGlobalVariables) {
+                if (!g_globalVariables || isIndirectValue(g_globalVariables->values[instructionArg])) {
+                    return false;
+                }
+                unsigned j;
+                for (j = 0; j < node->numGlobalVariables && node->globalVariables[j] != instructionArg; j++) {
+                }
+                if (j == node->numGlobalVariables) {
+                    if (node->numGlobalVariables == WATCH_MAX_GLOBAL_VARIABLES) {
+                        return false;
+                    }
+                    node->globalVariables[node->numGlobalVariables++] = instructionArg;
+                }
+            } else {
+#if EEZ_FLOW_NATIVE_VARIABLES_NOTIFY
+                node->readsNativeVariables = true;
+#else
+                return false;
+#endif
+            }
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_OPERATION) {
+            if (!isPureOperation(instructionArg)) {
+                return false;
+            }
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_END) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+}
+static uint32_t getWatchVersion(WatchListNode *node) {
+    uint32_t version = g_arrayElementsVersion;
+    if (node->readsLocalVariables) {
+        version += g_localVariablesVersion;
+    }
+    if (node->readsNativeVariables) {
+        version += g_nativeVariablesVersion;
+    }
+    for (unsigned i = 0; i < node->numGlobalVariables; i++) {
+        version += g_globalVariables->versions[node->globalVariables[i]];
+    }
+    return version;
+}
 WatchListNode *watchListAdd(FlowState *flowState, unsigned componentIndex) {
     auto node = (WatchListNode *)alloc(sizeof(WatchListNode), 0x00864d67);
     node->prev = g_watchList.last;
@@ -11198,6 +13683,11 @@ WatchListNode *watchListAdd(FlowState *flowState, unsigned componentIndex) {
     node->next = 0;
     node->flowState = flowState;
     node->componentIndex = componentIndex;
+    node->readsLocalVariables = false;
+    node->readsNativeVariables = false;
+    node->numGlobalVariables = 0;
+    node->polled = !analyzeWatchExpression(node);
+    node->version = node->polled ? 0 : getWatchVersion(node);
     incRefCounterForFlowState(flowState);
     (g_watchList.size)++;
     return node;
@@ -11220,7 +13710,15 @@ void visitWatchList() {
     for (auto node = g_watchList.first; node; ) {
         auto nextNode = node->next;
         if (canExecuteStep(node->flowState, node->componentIndex)) {
-            executeWatchVariableComponent(node->flowState, node->componentIndex);
+            if (node->polled) {
+                executeWatchVariableComponent(node->flowState, node->componentIndex);
+            } else {
+                auto version = getWatchVersion(node);
+                if (version != node->version) {
+                    node->version = version;
+                    executeWatchVariableComponent(node->flowState, node->componentIndex);
+                }
+            }
         }
         decRefCounterForFlowState(node->flowState);
         if (canFreeFlowState(node->flowState)) {
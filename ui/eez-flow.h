@@ -182,6 +182,7 @@ Unit getSmallestUnit(Unit unit, float min, float precision);
     VALUE_TYPE(JSON_MEMBER_VALUE)                   \
     VALUE_TYPE(EVENT)                               \
     VALUE_TYPE(PROPERTY_REF)                        \
+    VALUE_TYPE(PACKED_ARRAY_REF)                    \
     CUSTOM_VALUE_TYPES
 namespace eez {
 #define VALUE_TYPE(NAME) VALUE_TYPE_##NAME,
@@ -915,9 +916,12 @@ struct Ref {
 struct ArrayValue;
 struct ArrayElementValue;
 struct BlobRef;
+struct PackedArrayRef;
 struct PropertyRef;
 #if defined(EEZ_FOR_LVGL)
 struct LVGLEventRef;
+LVGLEventRef *allocLVGLEventRef(uint32_t id);
+void freeLVGLEventRef(Ref *ref);
 #endif
 #if defined(EEZ_DASHBOARD_API)
 namespace flow {
@@ -1032,6 +1036,11 @@ struct Value {
     void freeRef() {
 		if (options & VALUE_OPTIONS_REF) {
 			if (--refValue->refCounter == 0) {
+#if defined(EEZ_FOR_LVGL)
+                if (type == VALUE_TYPE_EVENT) {
+                    freeLVGLEventRef(refValue);
+                } else
+#endif
                 ObjectAllocator<Ref>::deallocate(refValue);
 			}
 		}
@@ -1143,6 +1152,9 @@ struct Value {
     }
 	bool isBlob() const {
         return type == VALUE_TYPE_BLOB_REF;
+    }
+	bool isPackedArray() const {
+        return type == VALUE_TYPE_PACKED_ARRAY_REF;
     }
 	bool isJson() const {
         return type == VALUE_TYPE_JSON;
@@ -1237,6 +1249,9 @@ struct Value {
     BlobRef *getBlob() const {
         return (BlobRef *)refValue;
     }
+    PackedArrayRef *getPackedArray() const {
+        return (PackedArrayRef *)refValue;
+    }
     void *getWidget() {
         return pVoidValue;
     }
@@ -1271,6 +1286,7 @@ struct Value {
     static Value makeJsonMemberRef(Value jsonValue, Value propertyName, uint32_t id);
     static Value makeBlobRef(const uint8_t *blob, uint32_t len, uint32_t id);
     static Value makeBlobRef(const uint8_t *blob1, uint32_t len1, const uint8_t *blob2, uint32_t len2, uint32_t id);
+    static Value makePackedArrayRef(int arraySize, int arrayType, uint32_t id);
 #if defined(EEZ_FOR_LVGL)
     static Value makeLVGLEventRef(uint32_t code, void *currentTarget, void *target, int32_t userData, uint32_t key, int32_t gestureDir, int32_t rotaryDiff, uint32_t id);
 #endif
@@ -1325,6 +1341,9 @@ struct ArrayValue {
 };
 struct ArrayValueRef : public Ref {
     ~ArrayValueRef();
+    uint32_t capacity;
+    // set when Value::clone() shares this array between containers; see detachArrayElement
+    bool cowShared;
 	ArrayValue arrayValue;
 };
 struct BlobRef : public Ref {
@@ -1336,6 +1355,28 @@ struct BlobRef : public Ref {
 	uint8_t *blob;
     uint32_t len;
 };
+// Opt-in (makePackedArrayRef, ArrayOf*(size, true)): element access, Array.length/slice/append/
+// insert/remove/clone, SortArray, toBool, toText and the ArrayOf* helpers accept it, other array
+// consumers (struct fields, widget data, string arrays) expect ARRAY_REF.
+struct PackedArrayRef : public Ref {
+    ~PackedArrayRef() {
+        if (data) {
+            eez::free(data);
+        }
+    }
+    uint32_t arraySize;
+    uint32_t arrayType;
+    uint32_t capacity;
+    uint32_t elementSize;
+    uint8_t *data;
+    static uint32_t getElementSize(uint32_t arrayType);
+    bool reserve(uint32_t minCapacity);
+    Value get(uint32_t elementIndex) const;
+    bool pack(const Value &value, uint8_t *dst) const;
+    bool set(uint32_t elementIndex, const Value &value) {
+        return pack(value, data + elementIndex * elementSize);
+    }
+};
 #if defined(EEZ_FOR_LVGL)
 struct LVGLEventRef : public Ref {
 	uint32_t code;
@@ -1345,6 +1386,7 @@ struct LVGLEventRef : public Ref {
     uint32_t key;
     int32_t gestureDir;
     int32_t rotaryDiff;
+    uint32_t time;
 };
 #endif
 struct PropertyRef : public Ref {
@@ -1397,6 +1439,12 @@ inline Value Value::getValue() const {
                 return Value();
             }
             return Value((uint32_t)blobRef->blob[arrayElementValue->elementIndex], VALUE_TYPE_UINT32);
+        } else if (arrayElementValue->arrayValue.isPackedArray()) {
+            auto packedArray = arrayElementValue->arrayValue.getPackedArray();
+            if (arrayElementValue->elementIndex < 0 || arrayElementValue->elementIndex >= (int)packedArray->arraySize) {
+                return Value();
+            }
+            return packedArray->get(arrayElementValue->elementIndex);
         } else {
             auto array = arrayElementValue->arrayValue.getArray();
             if (arrayElementValue->elementIndex < 0 || arrayElementValue->elementIndex >= (int)array->arraySize) {
@@ -1422,6 +1470,7 @@ inline Value Value::getValue() const {
     return *this;
 }
 bool assignValue(Value &dstValue, const Value &srcValue, uint32_t dstValueType = VALUE_TYPE_UNDEFINED);
+bool detachArrayElement(ArrayValue *array, uint32_t elementIndex);
 uint16_t getPageIndexFromValue(const Value &value);
 uint16_t getNumPagesFromValue(const Value &value);
 Value MakeRangeValue(uint16_t from, uint16_t to);
@@ -1444,6 +1493,9 @@ struct ArrayOf {
         return (size_t)value.getArray()->arraySize;
     }
     T at(int position) {
+        if (!detachArrayElement(value.getArray(), position)) {
+            return Value::makeError();
+        }
         return value.getArray()->values[position];
     }
     void at(int position, const T &point) {
@@ -1452,55 +1504,97 @@ struct ArrayOf {
 };
 struct ArrayOfInteger {
     Value value;
-    ArrayOfInteger(size_t size) {
-        value = Value::makeArrayRef((uint32_t)size, flow::defs_v3::ARRAY_TYPE_INTEGER, 0);
+    ArrayOfInteger(size_t size, bool packed = false) {
+        if (packed) {
+            value = Value::makePackedArrayRef((int)size, flow::defs_v3::ARRAY_TYPE_INTEGER, 0);
+        } else {
+            value = Value::makeArrayRef((uint32_t)size, flow::defs_v3::ARRAY_TYPE_INTEGER, 0);
+        }
     }
     ArrayOfInteger(Value value_) : value(value_) {}
     operator Value() const { return value; }
-    operator bool() const { return value.isArray(); }
+    operator bool() const { return value.isArray() || value.isPackedArray(); }
     size_t size() {
+        if (value.isPackedArray()) {
+            return (size_t)value.getPackedArray()->arraySize;
+        }
         return (size_t)value.getArray()->arraySize;
     }
     int at(int position) {
+        if (value.isPackedArray()) {
+            return value.getPackedArray()->get(position).getInt();
+        }
         return value.getArray()->values[position].getInt();
     }
     void at(int position, int intValue) {
+        if (value.isPackedArray()) {
+            value.getPackedArray()->set(position, Value(intValue, VALUE_TYPE_INT32));
+            return;
+        }
         value.getArray()->values[position] = Value(intValue, VALUE_TYPE_INT32);
     }
 };
 struct ArrayOfFloat {
     Value value;
-    ArrayOfFloat(size_t size) {
-        value = Value::makeArrayRef((uint32_t)size, flow::defs_v3::ARRAY_TYPE_INTEGER, 0);
+    ArrayOfFloat(size_t size, bool packed = false) {
+        if (packed) {
+            value = Value::makePackedArrayRef((int)size, flow::defs_v3::ARRAY_TYPE_FLOAT, 0);
+        } else {
+            value = Value::makeArrayRef((uint32_t)size, flow::defs_v3::ARRAY_TYPE_FLOAT, 0);
+        }
     }
     ArrayOfFloat(Value value_) : value(value_) {}
     operator Value() const { return value; }
-    operator bool() const { return value.isArray(); }
+    operator bool() const { return value.isArray() || value.isPackedArray(); }
     size_t size() {
+        if (value.isPackedArray()) {
+            return (size_t)value.getPackedArray()->arraySize;
+        }
         return (size_t)value.getArray()->arraySize;
     }
     float at(int position) {
+        if (value.isPackedArray()) {
+            return value.getPackedArray()->get(position).getFloat();
+        }
         return value.getArray()->values[position].getFloat();
     }
     void at(int position, float floatValue) {
+        if (value.isPackedArray()) {
+            value.getPackedArray()->set(position, Value(floatValue, VALUE_TYPE_FLOAT));
+            return;
+        }
         value.getArray()->values[position] = Value(floatValue, VALUE_TYPE_FLOAT);
     }
 };
 struct ArrayOfDouble {
     Value value;
-    ArrayOfDouble(size_t size) {
-        value = Value::makeArrayRef((uint32_t)size, flow::defs_v3::ARRAY_TYPE_INTEGER, 0);
+    ArrayOfDouble(size_t size, bool packed = false) {
+        if (packed) {
+            value = Value::makePackedArrayRef((int)size, flow::defs_v3::ARRAY_TYPE_DOUBLE, 0);
+        } else {
+            value = Value::makeArrayRef((uint32_t)size, flow::defs_v3::ARRAY_TYPE_DOUBLE, 0);
+        }
     }
     ArrayOfDouble(Value value_) : value(value_) {}
     operator Value() const { return value; }
-    operator bool() const { return value.isArray(); }
+    operator bool() const { return value.isArray() || value.isPackedArray(); }
     size_t size() {
+        if (value.isPackedArray()) {
+            return (size_t)value.getPackedArray()->arraySize;
+        }
         return (size_t)value.getArray()->arraySize;
     }
     double at(int position) {
+        if (value.isPackedArray()) {
+            return value.getPackedArray()->get(position).getDouble();
+        }
         return value.getArray()->values[position].getDouble();
     }
     void at(int position, double doubleValue) {
+        if (value.isPackedArray()) {
+            value.getPackedArray()->set(position, Value(doubleValue, VALUE_TYPE_DOUBLE));
+            return;
+        }
         value.getArray()->values[position] = Value(doubleValue, VALUE_TYPE_DOUBLE);
     }
 };
@@ -2283,12 +2377,19 @@ namespace eez {
 namespace flow {
 struct GlobalVariables {
     uint32_t count;
+    uint32_t *versions;
     Value values[1];
 };
 extern struct GlobalVariables *g_globalVariables;
 void initGlobalVariables(Assets *assets);
+void initFlowRuntimeInfo(Assets *assets);
+void freeFlowRuntimeInfo();
+uint32_t getFlowRuntimeInfoMemorySize();
+uint32_t getResolvedAssetsMemorySize();
+const uint16_t *getCallInputComponents(FlowState *flowState, uint32_t &numComponents);
 static const int UNDEFINED_VALUE_INDEX = 0;
 static const int NULL_VALUE_INDEX = 1;
+static const unsigned NO_COMPONENT_INDEX = 0xFFFFFFFF;
 #define TRACK_REF_COUNTER_FOR_COMPONENT_STATE(component) \
     !( \
         component->type == defs_v3::COMPONENT_TYPE_INPUT_ACTION || \
@@ -2302,6 +2403,9 @@ struct ComponenentExecutionState {
 struct CatchErrorComponenentExecutionState : public ComponenentExecutionState {
 	Value message;
 };
+#if !defined(EEZ_FLOW_RESOLVED_ASSETS)
+#define EEZ_FLOW_RESOLVED_ASSETS 0
+#endif
 struct FlowState {
 	uint32_t flowStateIndex;
 	Assets *assets;
@@ -2312,12 +2416,15 @@ struct FlowState {
 	bool error;
     bool deleteOnNextTick;
     uint32_t refCounter;
+    uint32_t numActiveChildren;
     FlowState *parentFlowState;
 	Component *parentComponent;
 	int parentComponentIndex;
     Value inputValue;
     Value *values;
 	ComponenentExecutionState **componenentExecutionStates;
+    uint32_t *componentFilledInputs;
+    uint8_t *componentExecutionStateSlots;
     bool *componenentAsyncStates;
     unsigned executingComponentIndex;
     float timelinePosition;
@@ -2329,7 +2436,28 @@ struct FlowState {
     FlowState *lastChild;
     FlowState *previousSibling;
     FlowState *nextSibling;
+#if EEZ_FLOW_RESOLVED_ASSETS
+    Component **resolvedComponents;
+    uint32_t *resolvedFirstInput;
+    uint16_t *resolvedInputs;
+#endif
 };
+inline Component *getComponent(FlowState *flowState, unsigned componentIndex) {
+#if EEZ_FLOW_RESOLVED_ASSETS
+    if (flowState->resolvedComponents) {
+        return flowState->resolvedComponents[componentIndex];
+    }
+#endif
+    return flowState->flow->components[componentIndex];
+}
+inline uint16_t getComponentInputIndex(FlowState *flowState, unsigned componentIndex, unsigned inputIndex) {
+#if EEZ_FLOW_RESOLVED_ASSETS
+    if (flowState->resolvedInputs) {
+        return flowState->resolvedInputs[flowState->resolvedFirstInput[componentIndex] + inputIndex];
+    }
+#endif
+    return flowState->flow->components[componentIndex]->inputs[inputIndex];
+}
 extern int g_selectedLanguage;
 extern FlowState *g_firstFlowState;
 extern FlowState *g_lastFlowState;
@@ -2340,16 +2468,21 @@ void decRefCounterForFlowState(FlowState *flowState);
 bool canFreeFlowState(FlowState *flowState);
 void freeFlowState(FlowState *flowState);
 void freeAllChildrenFlowStates(FlowState *flowState);
+#if !defined(EEZ_FLOW_STATE_POOL_SIZE)
+#define EEZ_FLOW_STATE_POOL_SIZE 4
+#endif
+void flowStatePoolReset();
 void deallocateComponentExecutionState(FlowState *flowState, unsigned componentIndex);
+void *allocComponentExecutionStateMemory(FlowState *flowState, unsigned componentIndex, size_t size);
 extern void onComponentExecutionStateChanged(FlowState *flowState, int componentIndex);
 template<class T>
 T *allocateComponentExecutionState(FlowState *flowState, unsigned componentIndex) {
     if (flowState->componenentExecutionStates[componentIndex]) {
         deallocateComponentExecutionState(flowState, componentIndex);
     }
-    auto executionState = ObjectAllocator<T>::allocate(0x72dc3bf4);
+    auto executionState = new (allocComponentExecutionStateMemory(flowState, componentIndex, sizeof(T))) T;
     flowState->componenentExecutionStates[componentIndex] = executionState;
-    auto component = flowState->flow->components[componentIndex];
+    auto component = getComponent(flowState, componentIndex);
     if (TRACK_REF_COUNTER_FOR_COMPONENT_STATE(component)) {
         incRefCounterForFlowState(flowState);
     }
@@ -2359,6 +2492,7 @@ T *allocateComponentExecutionState(FlowState *flowState, unsigned componentIndex
 void resetSequenceInputs(FlowState *flowState);
 void propagateValue(FlowState *flowState, unsigned componentIndex, unsigned outputIndex, const Value &value);
 void propagateValue(FlowState *flowState, unsigned componentIndex, unsigned outputIndex); 
+bool replaceQueuedValue(FlowState *flowState, unsigned componentIndex, unsigned outputIndex, const Value &queuedValue, const Value &value);
 void propagateValueThroughSeqout(FlowState *flowState, unsigned componentIndex); 
 #if EEZ_OPTION_GUI
 void getValue(uint16_t dataId, DataOperationEnum operation, const WidgetCursor &widgetCursor, Value &value);
@@ -2562,6 +2696,7 @@ struct EvalStack {
 	Value stack[STACK_SIZE];
 	size_t sp = 0;
     const char *errorMessage;
+    Value *assignmentTarget = nullptr;
 	bool push(const Value &value) {
 		if (sp >= STACK_SIZE) {
 			throwError(flowState, componentIndex, "Evaluation stack is full\n");
@@ -2581,12 +2716,16 @@ struct EvalStack {
         if (sp == 0) {
             return Value::makeError();
         }
-		return stack[--sp];
+        Value value;
+        memcpy((void *)&value, (void *)&stack[--sp], sizeof(Value));
+        new (&stack[sp]) Value();
+        return value;
 	}
     void setErrorMessage(const char *str) {
         errorMessage = str;
     }
 };
+extern EvalStack g_stack;
 #if EEZ_OPTION_GUI
 bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const FlowError &errorMessage, int *numInstructionBytes = nullptr, const int32_t *iterators = nullptr, eez::gui::DataOperationEnum operation = eez::gui::DATA_OPERATION_GET);
 #else
@@ -2618,6 +2757,8 @@ void tick();
 void stop();
 bool isFlowStopped();
 unsigned getTickMaxDurationCounter();
+bool isTickTimeBudgetSpent();
+uint32_t getLoopIterationCounter();
 #if EEZ_OPTION_GUI
 FlowState *getPageFlowState(Assets *assets, int16_t pageIndex, const WidgetCursor &widgetCursor);
 #else
@@ -2728,11 +2869,22 @@ bool peekNextTaskFromQueue(FlowState *&flowState, unsigned &componentIndex, bool
 void removeNextTaskFromQueue();
 bool isInQueue(FlowState *flowState, unsigned componentIndex);
 void removeTasksFromQueueForFlowState(FlowState *flowState);
+#if !defined(EEZ_FLOW_LOOP_FUSION)
+#define EEZ_FLOW_LOOP_FUSION 1
+#endif
+#if EEZ_FLOW_LOOP_FUSION
+void beginFusedTasks(FlowState *flowState);
+bool takeFusedTask(FlowState *flowState, unsigned &componentIndex);
+void endFusedTasks();
+#endif
 } 
 } 
 // -----------------------------------------------------------------------------
 // flow/watch_list.h
 // -----------------------------------------------------------------------------
+#ifndef EEZ_FLOW_NATIVE_VARIABLES_NOTIFY
+#define EEZ_FLOW_NATIVE_VARIABLES_NOTIFY 0
+#endif
 namespace eez {
 namespace flow {
 struct WatchListNode;
@@ -2742,9 +2894,80 @@ void visitWatchList();
 void watchListReset();
 void removeWatchesForFlowState(FlowState *flowState);
 unsigned getWatchListSize();
+void onVariableAssigned(const Value *pValue);
+void onArrayElementAssigned();
+void onNativeVariableAssigned();
 } 
 } 
 // -----------------------------------------------------------------------------
+// flow/dual_core.h
+// -----------------------------------------------------------------------------
+#ifndef EEZ_FLOW_DUAL_CORE
+#define EEZ_FLOW_DUAL_CORE 0
+#endif
+#if EEZ_FLOW_DUAL_CORE
+#include <atomic>
+namespace eez {
+namespace flow {
+template <typename T, uint32_t SIZE>
+struct SpscQueue {
+    static_assert((SIZE & (SIZE - 1)) == 0, "SpscQueue size must be power of 2");
+    T items[SIZE];
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    T *beginPush() {
+        auto t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == SIZE) {
+            return nullptr;
+        }
+        return &items[t & (SIZE - 1)];
+    }
+    void endPush() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    T *front() {
+        auto h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[h & (SIZE - 1)];
+    }
+    void pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    bool isFull() {
+        return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) == SIZE;
+    }
+    template <typename Callback>
+    void forEachPending(Callback callback) {
+        auto t = tail.load(std::memory_order_acquire);
+        for (auto h = head.load(std::memory_order_relaxed); h != t; h++) {
+            callback(items[h & (SIZE - 1)]);
+        }
+    }
+};
+void lockFlow();
+void unlockFlow();
+struct FlowLock {
+    FlowLock() { lockFlow(); }
+    ~FlowLock() { unlockFlow(); }
+};
+extern bool g_isExecutingOnLvglCore;
+bool mustExecuteOnLvglCore(FlowState *flowState, unsigned componentIndex);
+bool isLvglCoreQueueFull();
+void postToLvglCore(FlowState *flowState, unsigned componentIndex);
+void executePostedOnLvglCore();
+void executePostedEvents();
+void removePostedForFlowState(FlowState *flowState);
+void initFlowLock();
+void startFlowTask();
+} 
+} 
+#define EEZ_FLOW_LOCK() eez::flow::FlowLock flowLock
+#else
+#define EEZ_FLOW_LOCK()
+#endif
+// -----------------------------------------------------------------------------
 // flow/components/call_action.h
 // -----------------------------------------------------------------------------
 namespace eez {
@@ -2867,6 +3090,18 @@ struct LVGLApiComponent_ActionType {
 struct LVGLApiComponent : public Component {
     ListOfAssetsPtr<LVGLApiComponent_ActionType> actions;
 };
+#if !defined(EEZ_FLOW_LVGL_MAX_PENDING_WRITES)
+#define EEZ_FLOW_LVGL_MAX_PENDING_WRITES 256
+#endif
+void flushLvglWrites();
+void flushLvglLayout();
+void onLvglObjectsCreated();
+void onLvglFlowStateError(FlowState *flowState);
+void removeLvglWaitsForFlowState(FlowState *flowState);
+void lvglWaitListReset();
+void lvglPendingWritesReset();
+void resetLvglEventCoalescing();
+void updateLvglEventLatency();
 } 
 } 
 // -----------------------------------------------------------------------------
@@ -2952,7 +3187,8 @@ struct SortArrayActionComponent : public Component {
     int32_t structFieldIndex;
     uint32_t flags;
 };
-void sortArray(SortArrayActionComponent *component, ArrayValue *array);
+bool sortArray(SortArrayActionComponent *component, ArrayValue *array);
+bool sortArray(SortArrayActionComponent *component, PackedArrayRef *packedArray);
 } 
 } 
 // -----------------------------------------------------------------------------
@@ -3019,6 +3255,22 @@ typedef struct _ext_img_desc_t {
 } ext_img_desc_t;
 #endif
 typedef void (*ActionExecFunc)(lv_event_t * e);
+typedef struct _eez_flow_screen_stats_t {
+    uint32_t memSize;
+    uint32_t createTime;
+    uint32_t navigationTime;
+    uint32_t numCreates;
+    uint32_t numNavigations;
+    uint32_t numCacheHits;
+} eez_flow_screen_stats_t;
+typedef struct _eez_flow_event_stats_t {
+    uint32_t numEvents;
+    uint32_t numCoalescedEvents;
+    uint32_t numPoolMisses;
+    uint32_t maxQueueSize;
+    uint32_t lastLatency;
+    uint32_t maxLatency;
+} eez_flow_event_stats_t;
 void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj_t **objects, size_t numObjects, const ext_img_desc_t *images, size_t numImages, ActionExecFunc *actions);
 void eez_flow_init_styles(
     void (*add_style)(lv_obj_t *obj, int32_t styleIndex),
@@ -3032,8 +3284,15 @@ void eez_flow_init_style_names(const char **styleNames, size_t numStyles);
 void eez_flow_init_themes(const char **themeNames, size_t numThemes, void (*changeColorTheme)(uint32_t themeIndex));
 void eez_flow_set_create_screen_func(void (*createScreenFunc)(int screenIndex));
 void eez_flow_set_delete_screen_func(void (*deleteScreenFunc)(int screenIndex));
+void eez_flow_set_event_coalescing(bool enable);
+void eez_flow_get_event_stats(eez_flow_event_stats_t *stats);
+void eez_flow_reset_event_stats();
+void eez_flow_set_screen_cache_budget(size_t budget);
+void eez_flow_set_screen_neighbours(int16_t screenId, const int16_t *neighbourScreenIds, size_t numNeighbours);
+bool eez_flow_get_screen_stats(int16_t screenId, eez_flow_screen_stats_t *stats);
 void eez_flow_tick();
 bool eez_flow_is_stopped();
+void eez_flow_native_var_changed();
 extern int16_t g_currentScreen;
 int16_t eez_flow_get_current_screen();
 void eez_flow_set_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay);